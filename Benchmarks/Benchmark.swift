@@ -0,0 +1,66 @@
+//
+// MMMLoadable. Part of MMMTemple.
+// Copyright (C) 2016-2020 MediaMonks. All rights reserved.
+//
+
+import Foundation
+
+/// A tiny helper measuring the time and heap usage per operation for the benchmarks in this target.
+///
+/// Results are printed in a single line per benchmark in the following format, so they are easy to grep in CI logs:
+///
+///     [benchmark] <name>: <time> ns/op, <blocks> net blocks/op
+///
+/// Note that "net blocks/op" is the number of heap blocks that remain allocated per operation (i.e. allocations minus
+/// deallocations as reported by the default malloc zone), so temporary allocations freed within the same operation
+/// are not counted.
+internal enum Benchmark {
+
+	internal struct Result {
+		let nsPerOp: Double
+		let netBlocksPerOp: Double
+	}
+
+	/// Runs `body` for warming up first and then `iterations` times more measuring the time and heap usage.
+	/// The iteration number is passed to the body.
+	@discardableResult
+	internal static func run(
+		_ name: String,
+		iterations: Int,
+		warmUpIterations: Int? = nil,
+		_ body: (_ iteration: Int) -> Void
+	) -> Result {
+
+		precondition(iterations > 0)
+
+		for i in 0..<(warmUpIterations ?? max(iterations / 10, 1)) {
+			body(i)
+		}
+
+		let blocksBefore = heapBlocksInUse()
+		let start = DispatchTime.now().uptimeNanoseconds
+		for i in 0..<iterations {
+			body(i)
+		}
+		let end = DispatchTime.now().uptimeNanoseconds
+		let blocksAfter = heapBlocksInUse()
+
+		let result = Result(
+			nsPerOp: Double(end - start) / Double(iterations),
+			netBlocksPerOp: Double(blocksAfter - blocksBefore) / Double(iterations)
+		)
+		print(String(format: "[benchmark] %@: %.1f ns/op, %.2f net blocks/op", name, result.nsPerOp, result.netBlocksPerOp))
+
+		return result
+	}
+
+	private static func heapBlocksInUse() -> Int {
+		#if canImport(Darwin)
+		var stats = malloc_statistics_t()
+		malloc_zone_statistics(nil, &stats)
+		return Int(stats.blocks_in_use)
+		#else
+		return 0
+		#endif
+	}
+}
@@ -0,0 +1,243 @@
+//
+// MMMLoadable. Part of MMMTemple.
+// Copyright (C) 2016-2020 MediaMonks. All rights reserved.
+//
+
+import MMMCommonCore
+import MMMLoadable
+import XCTest
+
+/// Throughput of the notification hot path. Run with `-only-testing:MMMLoadableBenchmarks` and grep for "[benchmark]".
+///
+/// Everything time-related is driven by `MMMMockTimeSource`, so no benchmark waits for real timeouts.
+class MMMLoadableBenchmarks: XCTestCase {
+
+	func testNotifyFanOut() {
+
+		for observerCount in [1, 10, 1000] {
+
+			let loadable = MMMPureLoadable()
+			var calls = 0
+			let observers = (0..<observerCount).map { _ in
+				MMMLoadableObserver(loadable: loadable) { _ in calls += 1 }
+			}
+
+			Benchmark.run("notifyDidChange, \(observerCount) observer(s)", iterations: 100_000 / observerCount) { _ in
+				loadable.setDidSyncSuccessfully()
+			}
+
+			XCTAssert(calls > 0)
+			withExtendedLifetime(observers) {}
+		}
+	}
+
+	@objc private func loadableDidChange(_ loadable: MMMPureLoadableProtocol) {
+		selectorCalls += 1
+	}
+
+	private var selectorCalls = 0
+
+	/// Forwards to a target/selector via `performSelector:withObject:` on every notification, like the selector proxy
+	/// of `MMMLoadableObserver` used to do before it started caching the IMP.
+	private final class PerformSelectorObserver: NSObject, MMMLoadableObserverProtocol {
+
+		private weak var target: NSObject?
+		private let selector: Selector
+
+		init(target: NSObject, selector: Selector) {
+			self.target = target
+			self.selector = selector
+		}
+
+		func loadableDidChange(_ loadable: MMMPureLoadableProtocol) {
+			_ = target?.perform(selector, with: loadable)
+		}
+	}
+
+	func testSelectorObserver() {
+
+		let selector = #selector(loadableDidChange(_:))
+
+		// The same path for both: every child of a group changes and is observed via a target/selector pair,
+		// only the way the selector is called differs.
+		for childCount in [10, 1000] {
+
+			let children = (0..<childCount).map { _ in MMMPureLoadable() }
+			let group = MMMPureLoadableGroup(loadables: children)
+			let iterations = 200_000
+
+			let performObservers = children.map { child -> PerformSelectorObserver in
+				let observer = PerformSelectorObserver(target: self, selector: selector)
+				child.addObserver(observer)
+				return observer
+			}
+			Benchmark.run("group of \(childCount), child change, performSelector:withObject:", iterations: iterations) { i in
+				children[i % childCount].setDidSyncSuccessfully()
+			}
+			zip(children, performObservers).forEach { $0.removeObserver($1) }
+
+			let impObservers = children.map { MMMLoadableObserver(loadable: $0, target: self, selector: selector) }
+			Benchmark.run("group of \(childCount), child change, cached IMP", iterations: iterations) { i in
+				children[i % childCount].setDidSyncSuccessfully()
+			}
+			impObservers.forEach { $0?.remove() }
+
+			withExtendedLifetime(group) {}
+		}
+
+		XCTAssert(selectorCalls > 0)
+	}
+
+	func testGroupUpdates() {
+
+		for childCount in [10, 100, 1000, 10_000] {
+
+			let children = (0..<childCount).map { _ in MMMPureLoadable() }
+			let group = MMMPureLoadableGroup(loadables: children)
+			let observer = MMMLoadableObserver(loadable: group) { _ in }
+
+			// Every child goes through "syncing" and "synced" one after another, so the group changes too.
+			Benchmark.run("group of \(childCount), child change", iterations: 20_000) { i in
+				let child = children[i % childCount]
+				if i % 2 == 0 {
+					child.setSyncing()
+				} else {
+					child.setDidSyncSuccessfully()
+				}
+			}
+
+			withExtendedLifetime(observer) {}
+		}
+	}
+
+	func testProxyChains() {
+
+		for depth in [1, 10, 100] {
+
+			let target = MMMPureLoadable()
+			var proxies: [MMMPureLoadableProxy] = []
+			var last: MMMPureLoadableProtocol = target
+			for _ in 0..<depth {
+				let proxy = MMMPureLoadableProxy()
+				proxy.loadable = last
+				proxies.append(proxy)
+				last = proxy
+			}
+			var calls = 0
+			let observer = MMMLoadableObserver(loadable: last) { _ in calls += 1 }
+
+			Benchmark.run("proxy chain of \(depth), change", iterations: 100_000 / depth) { _ in
+				target.setDidSyncSuccessfully()
+			}
+
+			XCTAssert(calls > 0)
+			withExtendedLifetime(observer) {}
+		}
+	}
+
+	/// Runs the main queue till everything that has been scheduled on it so far is done.
+	private func drainMainQueue() {
+		let drained = expectation(description: "Main queue drained")
+		DispatchQueue.main.async { drained.fulfill() }
+		wait(for: [drained], timeout: 60)
+	}
+
+	private func report(_ name: String, from start: UInt64, to end: UInt64, count: Int) {
+		print(String(format: "[benchmark] %@: %.1f ns/op", name, Double(end - start) / Double(count)))
+	}
+
+	/// A waiter with `requestCount` requests that are actually pending, i.e. sitting in its heap, when this returns.
+	/// The completion of the last of them records the time and fulfills the returned expectation.
+	private func waiterWithPendingRequests(
+		_ requestCount: Int
+	) -> (MMMTestLoadable, MMMMockTimeSource, MMMLoadableWaiter, XCTestExpectation, () -> UInt64) {
+
+		let loadable = MMMTestLoadable()
+		let timeSource = MMMMockTimeSource(scale: 0.01)
+		let waiter = MMMLoadableWaiter(
+			loadable: loadable,
+			condition: .didSyncSuccessfully,
+			timeout: 3600,
+			shouldSyncIfPossible: false,
+			queue: nil,
+			timeSource: timeSource
+		)
+
+		let done = expectation(description: "All requests completed")
+		var completed = 0
+		var end: UInt64 = 0
+
+		// `wait()` only schedules the insertion on the queue of the waiter (main here), so the insertions are timed
+		// as well: they all run before the marker block of `drainMainQueue()`.
+		let start = DispatchTime.now().uptimeNanoseconds
+		for _ in 0..<requestCount {
+			waiter.wait { _ in
+				completed += 1
+				if completed == requestCount {
+					end = DispatchTime.now().uptimeNanoseconds
+					done.fulfill()
+				}
+			}
+		}
+		drainMainQueue()
+		report(
+			"waiter, \(requestCount) pending, wait() and insertion",
+			from: start, to: DispatchTime.now().uptimeNanoseconds, count: requestCount
+		)
+		XCTAssertEqual(completed, 0)
+
+		return (loadable, timeSource, waiter, done, { end })
+	}
+
+	func testWaiterWithManyPendingRequests() {
+
+		for requestCount in [10, 1000, 5000] {
+
+			// Resolving: the condition is reached, so all the pending requests complete at once.
+			do {
+				let (loadable, _, waiter, done, end) = waiterWithPendingRequests(requestCount)
+				let start = DispatchTime.now().uptimeNanoseconds
+				loadable.setDidSyncSuccessfully()
+				wait(for: [done], timeout: 60)
+				report("waiter, \(requestCount) pending, resolving", from: start, to: end(), count: requestCount)
+				withExtendedLifetime(waiter) {}
+			}
+
+			// Expiring: the mock time is moved past the timeout of all the requests, the change of the target
+			// (with the condition still not reached) makes the waiter look at them without waiting for the real timer.
+			do {
+				let (loadable, timeSource, waiter, done, end) = waiterWithPendingRequests(requestCount)
+				timeSource.now = timeSource.now.addingTimeInterval(3601)
+				let start = DispatchTime.now().uptimeNanoseconds
+				loadable.notifyDidChange()
+				wait(for: [done], timeout: 60)
+				report("waiter, \(requestCount) pending, expiring", from: start, to: end(), count: requestCount)
+				withExtendedLifetime(waiter) {}
+			}
+		}
+	}
+
+	func testSyncerRescheduling() {
+
+		let loadable = MMMTestLoadable()
+		let timeSource = MMMMockTimeSource(scale: 0.01)
+		// Long enough periods, so the timers never fire while measuring.
+		let syncer = MMMLoadableSyncer(
+			loadable: loadable,
+			period: 3600,
+			backoff: (min: 3600, max: 7200, multiplier: 2),
+			timeSource: timeSource
+		)
+
+		// Each change of the target reschedules the syncer.
+		Benchmark.run("syncer, reschedule", iterations: 20_000) { i in
+			if i % 2 == 0 {
+				loadable.setDidSyncSuccessfully()
+			} else {
+				loadable.setDidFailToSyncWithError(nil)
+			}
+		}
+
+		withExtendedLifetime(syncer) {}
+	}
+}
@@ -43,6 +43,14 @@ let package = Package(
 				"MMMCommonCore"
 			],
             path: "Tests"
+		),
+        .testTarget(
+            name: "MMMLoadableBenchmarks",
+            dependencies: [
+				"MMMLoadable",
+				"MMMCommonCore"
+			],
+            path: "Benchmarks"
 		)
     ]
 )
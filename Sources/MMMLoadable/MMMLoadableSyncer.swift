@@ -36,21 +36,27 @@ public final class MMMLoadableSyncer {
 	private let syncPolicy: SyncPolicy
 
 	private let timeSource: MMMTimeSource
+	private let timerLeeway: DispatchTimeInterval
 
 	private var didBecomeActiveObserver: NSObjectProtocol?
 
 	/// Designated initializer allowing to customize the timeout policy, something that can be useful at least for testing.
+	///
+	/// - Parameter timerLeeway: How late the system can fire the timer triggering the next sync,
+	///   a larger value allows it to save energy by coalescing wakeups.
 	public init(
 		loadable: MMMLoadableProtocol,
 		syncPolicy: SyncPolicy = .sync,
 		timeoutPolicy: MMMTimeoutPolicy,
-		timeSource: MMMTimeSource? = nil
+		timeSource: MMMTimeSource? = nil,
+		timerLeeway: DispatchTimeInterval = .nanoseconds(0)
 	) {
 
 		self.loadable = loadable
 		self.syncPolicy = syncPolicy
 		self.timeoutPolicy = timeoutPolicy
 		self.timeSource = timeSource ?? MMMDefaultTimeSource()
+		self.timerLeeway = timerLeeway
 
 		self.loadableObserver = MMMLoadableObserver(loadable: loadable) { [weak self] _ in
 			self?.reschedule()
@@ -77,12 +83,15 @@ public final class MMMLoadableSyncer {
 	/// - Parameter period: How often to sync the target after it has been synced successfully. 0 to disable.
 	/// - Parameter backoff: Describes how often to retry syncing the target after a failure and how this timeout
 	///   should grow after each attempt.
+	/// - Parameter jitter: How to randomize the retry timeouts, see `MMMBackoffTimeoutPolicy.Jitter`.
 	public convenience init(
 		loadable: MMMLoadableProtocol,
 		syncPolicy: SyncPolicy = .sync,
 		period: TimeInterval,
 		backoff: BackoffSettings,
-		timeSource: MMMTimeSource? = nil
+		jitter: MMMBackoffTimeoutPolicy.Jitter = .none,
+		timeSource: MMMTimeSource? = nil,
+		timerLeeway: DispatchTimeInterval = .nanoseconds(0)
 	) {
 		self.init(
 			loadable: loadable,
@@ -91,9 +100,11 @@ public final class MMMLoadableSyncer {
 				period: period,
 				min: backoff.min,
 				max: backoff.max,
-				multiplier: backoff.multiplier
+				multiplier: backoff.multiplier,
+				jitter: jitter
 			),
-			timeSource: timeSource
+			timeSource: timeSource,
+			timerLeeway: timerLeeway
 		)
 	}
 
@@ -102,23 +113,26 @@ public final class MMMLoadableSyncer {
 		didBecomeActiveObserver.map { NotificationCenter.default.removeObserver($0) }
 	}
 
-	private var timer: Timer?
+	// A dispatch source on the main queue (where the loadables live) rather than a `Timer` bound to the run loop
+	// of the current thread.
+	private var timer: DispatchSourceTimer?
 
 	private func cancelTimer() {
-		timer?.invalidate()
+		timer?.cancel()
 		timer = nil
 	}
 
 	private func setTimer(timeout: TimeInterval) {
 
 		let t = max(timeout, 0)
-		timer?.invalidate()
-		timer = Timer.scheduledTimer(
-			withTimeInterval: timeSource.realTimeIntervalFrom(timeout),
-			repeats: false
-		) { [weak self] _ in
+		cancelTimer()
+		let timer = DispatchSource.makeTimerSource(queue: .main)
+		timer.schedule(deadline: .now() + timeSource.realTimeIntervalFrom(t), leeway: timerLeeway)
+		timer.setEventHandler { [weak self] in
 			self?.sync()
 		}
+		timer.resume()
+		self.timer = timer
 
 		guard let loadable = loadable else { preconditionFailure() }
 		
@@ -195,15 +209,40 @@ public protocol MMMTimeoutPolicy: AnyObject {
 /// after failures.
 public final class MMMBackoffTimeoutPolicy: MMMTimeoutPolicy {
 
+	/// How the timeouts after failures are randomized, so many clients failing at the same time
+	/// (e.g. during an outage of the backend) don't retry all at once.
+	public enum Jitter {
+
+		/// No randomization: `min`, `min * multiplier`, `min * multiplier^2`, ... up to `max`.
+		case none
+
+		/// A random timeout between 0 and the one `none` would give.
+		case full
+
+		/// Half of the timeout `none` would give plus a random value up to the other half.
+		case equal
+
+		/// A random timeout between `min` and 3 times the previous one (but no more than `max`),
+		/// i.e. not tied to the number of failures.
+		case decorrelated
+	}
+
 	private let min: TimeInterval
 	private let max: TimeInterval
 	private let multiplier: Double
+	private let jitter: Jitter
+	private var random: AnyRandomNumberGenerator
 
+	/// - Parameter randomSource: The source of randomness for the `jitter`; pass something seeded
+	///   (e.g. `MMMSeededRandomNumberGenerator`) to make the timeouts reproducible in tests.
+	///   The system generator is used by default.
 	public init(
 		period: TimeInterval = 0,
 		min: TimeInterval,
 		max: TimeInterval,
-		multiplier: Double = 2.0.squareRoot()
+		multiplier: Double = 2.0.squareRoot(),
+		jitter: Jitter = .none,
+		randomSource: RandomNumberGenerator? = nil
 	) {
 
 		assert(period >= 0)
@@ -215,21 +254,37 @@ public final class MMMBackoffTimeoutPolicy: MMMTimeoutPolicy {
 		self.min = min
 		self.max = max
 		self.multiplier = multiplier
+		self.jitter = jitter
+		self.random = AnyRandomNumberGenerator(randomSource ?? SystemRandomNumberGenerator())
 
 		reset()
 	}
 
 	private var upperBound: TimeInterval = 0
 
+	// The timeout returned last time, for the "decorrelated" jitter.
+	private var previous: TimeInterval = 0
+
 	public func reset() {
 		upperBound = min
+		previous = min
 	}
 
 	public func nextTimeout(afterFailure: Bool) -> TimeInterval {
 		if afterFailure {
-			// Could be `TimeInterval.random(in: min...upperBound)`, but being deterministic makes it easier to test.
-			let next = upperBound
+			let next: TimeInterval
+			switch jitter {
+			case .none:
+				next = upperBound
+			case .full:
+				next = TimeInterval.random(in: 0...upperBound, using: &random)
+			case .equal:
+				next = upperBound / 2 + TimeInterval.random(in: 0...(upperBound / 2), using: &random)
+			case .decorrelated:
+				next = Swift.min(TimeInterval.random(in: min...Swift.max(min, previous * 3), using: &random), max)
+			}
 			upperBound = Swift.min(upperBound * multiplier, max)
+			previous = next
 			return next
 		} else {
 			reset()
@@ -243,3 +298,36 @@ public final class MMMBackoffTimeoutPolicy: MMMTimeoutPolicy {
 	/// because there is no feedback between the policy and the syncer.
 	public var period: TimeInterval
 }
+
+/// A simple pseudo-random number generator (SplitMix64) giving the same sequence for the same seed,
+/// to be injected into `MMMBackoffTimeoutPolicy` in tests.
+public struct MMMSeededRandomNumberGenerator: RandomNumberGenerator {
+
+	private var state: UInt64
+
+	public init(seed: UInt64) {
+		self.state = seed
+	}
+
+	public mutating func next() -> UInt64 {
+		state &+= 0x9E3779B97F4A7C15
+		var z = state
+		z = (z ^ (z >> 30)) &* 0xBF58476D1CE4E5B9
+		z = (z ^ (z >> 27)) &* 0x94D049BB133111EB
+		return z ^ (z >> 31)
+	}
+}
+
+/// Allows to store any generator and still pass it to the generic `random(in:using:)`.
+private struct AnyRandomNumberGenerator: RandomNumberGenerator {
+
+	private var base: RandomNumberGenerator
+
+	init(_ base: RandomNumberGenerator) {
+		self.base = base
+	}
+
+	mutating func next() -> UInt64 {
+		return base.next()
+	}
+}
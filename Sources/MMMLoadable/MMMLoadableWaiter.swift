@@ -36,33 +36,30 @@ public final class MMMLoadableWaiter {
 	private var observer: MMMLoadableObserver?
 	private let queue: DispatchQueue
 	private let timeSource: MMMTimeSource
-
-	private var syncCount: Int = 0
+	private let timerLeeway: DispatchTimeInterval
 
 	/// - Parameter shouldSyncIfPossible: When `true`, then the target loadable will be synced while somebody is waiting
 	///   (provided allows syncing as well, i.e. supports `MMMLoadableProtocol`).
+	/// - Parameter timerLeeway: How late the system can fire the timer expiring the requests,
+	///   a larger value allows it to save energy by coalescing wakeups.
 	public init(
 		loadable: MMMPureLoadableProtocol,
 		condition: Condition,
 		timeout: TimeInterval,
 		shouldSyncIfPossible: Bool,
 		queue: DispatchQueue? = nil,
-		timeSource: MMMTimeSource? = nil
+		timeSource: MMMTimeSource? = nil,
+		timerLeeway: DispatchTimeInterval = .nanoseconds(0)
 	) {
 		self.loadable = loadable
 		self.condition = condition
 		self.timeout = timeout
 		self.queue = queue ?? DispatchQueue.main
 		self.timeSource = timeSource ?? MMMDefaultTimeSource()
+		self.timerLeeway = timerLeeway
 
 		self.observer = MMMLoadableObserver(loadable: loadable) { [weak self] _ in
-			guard let self = self else { return }
-			// Attempts are counted every time it transitions via "syncing".
-			if self.loadable.loadableState == .syncing {
-				// Increments are atomic, but "read and zero out" would not be.
-				self.queue.async { self.syncCount += 1 }
-			}
-			self.callback.schedule()
+			self?.callback.schedule()
 		}
 	}
 
@@ -76,13 +73,44 @@ public final class MMMLoadableWaiter {
 
 	public typealias Completion = (Result<MMMPureLoadableProtocol, Error>) -> Void
 
-	public func wait(_ completion: @escaping Completion) {
-		let r = WaitRequest(completion: completion, expiresAt: timeSource.now.addingTimeInterval(timeout))
+	/// Calls the completion on the queue of the waiter when the target reaches the condition or when the timeout expires.
+	///
+	/// The returned request can be used to stop waiting, see `WaitRequest.cancel()`.
+	@discardableResult
+	public func wait(_ completion: @escaping Completion) -> WaitRequest {
+		let r = WaitRequest(waiter: self, completion: completion, expiresAt: timeSource.now.addingTimeInterval(timeout))
 		queue.async { [weak self] in
-			guard let self = self else { return }
-			self.requests.append(r)
+			guard let self = self, !r.isCancelled else { return }
+			self.requests.insert(r)
 			self.update()
 		}
+		return r
+	}
+
+	/// Same as `wait()`, but when `completingSynchronouslyIfReady` is `true` and the target has reached the condition
+	/// already, then the completion is called right away on the current queue (rather than on the queue of the waiter)
+	/// and `nil` is returned. This avoids allocating a request and hopping queues in the common case.
+	///
+	/// Note that the target is checked on the current queue, so use this only where it's safe to read the target,
+	/// e.g. on the main queue for the most of loadables.
+	@discardableResult
+	public func wait(completingSynchronouslyIfReady: Bool, _ completion: @escaping Completion) -> WaitRequest? {
+		if completingSynchronouslyIfReady && hasReachedCondition() {
+			completion(.success(loadable))
+			return nil
+		}
+		return wait(completion)
+	}
+
+	fileprivate func cancel(_ r: WaitRequest) {
+		queue.async { [weak self] in
+			guard let self = self, !r.isCancelled else { return }
+			r.isCancelled = true
+			if self.requests.remove(r), self.requests.isEmpty {
+				// To stop the timer and the syncer.
+				self.update()
+			}
+		}
 	}
 
 	private func hasReachedCondition() -> Bool {
@@ -94,20 +122,23 @@ public final class MMMLoadableWaiter {
 		}
 	}
 
-	private var timer: Timer?
+	// A dispatch source rather than a `Timer`, so it fires right on our queue, which does not need a run loop.
+	private var timer: DispatchSourceTimer?
 
 	private func setUpTimer(_ timeInterval: TimeInterval) {
 		let t = timeSource.realTimeIntervalFrom(max(timeInterval, 0))
-		timer?.invalidate()
-		timer = Timer.scheduledTimer(withTimeInterval: t, repeats: false) { [weak self] _ in
-			self?.queue.async {
-				self?.update()
-			}
+		cancelTimer()
+		let timer = DispatchSource.makeTimerSource(queue: queue)
+		timer.schedule(deadline: .now() + t, leeway: timerLeeway)
+		timer.setEventHandler { [weak self] in
+			self?.update()
 		}
+		timer.resume()
+		self.timer = timer
 	}
 
 	private func cancelTimer() {
-		timer?.invalidate()
+		timer?.cancel()
 		timer = nil
 	}
 
@@ -124,15 +155,15 @@ public final class MMMLoadableWaiter {
 		cancelTimer()
 
 		guard !requests.isEmpty else {
-			// Nobody needs anything yet, nothing to do.
+			// Nobody needs anything (anymore), nothing to do.
+			cleanUpAfterAllRequestsAreGone()
 			return
 		}
 
 		guard !hasReachedCondition() else {
 
 			// Alright, all pending requests are done.
-			let toComplete = requests
-			requests.removeAll()
+			let toComplete = requests.removeAll()
 			toComplete.forEach { $0.completion(.success(loadable)) }
 
 			cleanUpAfterAllRequestsAreGone()
@@ -153,54 +184,139 @@ public final class MMMLoadableWaiter {
 			loadable.syncIfNeeded()
 		}
 
-		// Not yet, let's remove the expired ones.
-
-		let syncCount = self.syncCount
-		self.syncCount = 0
-		for r in requests {
-			r.retryCount += syncCount
-		}
+		// Not yet, let's remove the expired ones, which are all at the top of the heap.
 
 		let now = timeSource.now
 		var toExpire: [WaitRequest] = []
-		var valid: [WaitRequest] = []
-		for r in requests {
-			if now < r.expiresAt {
-				valid.append(r)
-			} else {
-				toExpire.append(r)
-			}
+		while let r = requests.first, r.expiresAt <= now {
+			_ = requests.popFirst()
+			toExpire.append(r)
 		}
 
-		self.requests = valid
 		toExpire.forEach {
 			$0.completion(.failure(MMMLoadableWaiterError.timedOut))
 		}
 
-		var updateIn: TimeInterval?
-		for r in requests {
-			let left = r.expiresAt.timeIntervalSince(now)
-			updateIn = min(left, updateIn ?? left)
-		}
-		if let updateIn = updateIn {
-			setUpTimer(updateIn)
+		if let next = requests.first {
+			setUpTimer(next.expiresAt.timeIntervalSince(now))
 		} else {
 			cleanUpAfterAllRequestsAreGone()
 		}
 	}
 
-	private var requests: [WaitRequest] = []
+	private var requests = RequestHeap()
+
+	/// A single call of `wait()`.
+	public final class WaitRequest {
 
-	private class WaitRequest {
+		fileprivate let completion: Completion
+		fileprivate let expiresAt: Date
 
-		public let completion: Completion
-		public let expiresAt: Date
-		public var retryCount: Int = 0
+		private weak var waiter: MMMLoadableWaiter?
 
-		public init(completion: @escaping Completion, expiresAt: Date) {
+		// These are accessed on the queue of the waiter only.
+		fileprivate var isCancelled: Bool = false
+		fileprivate var heapIndex: Int = -1
+
+		fileprivate init(waiter: MMMLoadableWaiter, completion: @escaping Completion, expiresAt: Date) {
+			self.waiter = waiter
 			self.completion = completion
 			self.expiresAt = expiresAt
 		}
+
+		/// Stops waiting: the completion won't be called, unless it's been called or is being called already.
+		/// Can be called on any queue.
+		public func cancel() {
+			waiter?.cancel(self)
+		}
+	}
+
+	/// Binary min-heap of pending requests by their expiration time, so the ones to expire and the time of the next
+	/// expiration can be found without looking at all of them. Every request knows its index in the heap, so removing
+	/// a cancelled one does not need a scan either.
+	private struct RequestHeap {
+
+		private var items: [WaitRequest] = []
+
+		var isEmpty: Bool { items.isEmpty }
+
+		/// The request expiring first.
+		var first: WaitRequest? { items.first }
+
+		mutating func insert(_ r: WaitRequest) {
+			r.heapIndex = items.count
+			items.append(r)
+			siftUp(items.count - 1)
+		}
+
+		mutating func popFirst() -> WaitRequest? {
+			guard let r = items.first else { return nil }
+			_ = remove(r)
+			return r
+		}
+
+		/// Returns `false` if the request is not in the heap.
+		mutating func remove(_ r: WaitRequest) -> Bool {
+
+			let i = r.heapIndex
+			guard 0 <= i && i < items.count && items[i] === r else { return false }
+
+			let last = items.count - 1
+			if i != last {
+				swapAt(i, last)
+			}
+			items.removeLast()
+			r.heapIndex = -1
+
+			if i < items.count {
+				siftDown(i)
+				siftUp(i)
+			}
+
+			return true
+		}
+
+		/// Removes all the requests returning them in no particular order.
+		mutating func removeAll() -> [WaitRequest] {
+			let result = items
+			items.removeAll()
+			result.forEach { $0.heapIndex = -1 }
+			return result
+		}
+
+		private mutating func swapAt(_ i: Int, _ j: Int) {
+			items.swapAt(i, j)
+			items[i].heapIndex = i
+			items[j].heapIndex = j
+		}
+
+		private mutating func siftUp(_ index: Int) {
+			var i = index
+			while i > 0 {
+				let parent = (i - 1) / 2
+				guard items[i].expiresAt < items[parent].expiresAt else { break }
+				swapAt(i, parent)
+				i = parent
+			}
+		}
+
+		private mutating func siftDown(_ index: Int) {
+			var i = index
+			while true {
+				let left = 2 * i + 1
+				let right = left + 1
+				var smallest = i
+				if left < items.count && items[left].expiresAt < items[smallest].expiresAt {
+					smallest = left
+				}
+				if right < items.count && items[right].expiresAt < items[smallest].expiresAt {
+					smallest = right
+				}
+				guard smallest != i else { break }
+				swapAt(i, smallest)
+				i = smallest
+			}
+		}
 	}
 }
 
@@ -37,13 +37,33 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (void)doSync;
 
-/** Subclasses can notify the observers about a change in the object as well. */
+/**
+ * Subclasses can override this to stop the work started in `doSync` (cancel a network request, etc).
+ * Called from `cancelSync` while still 'syncing'; the state is changed to 'idle' right after this unless
+ * the implementation has changed it already. Note that the results of the cancelled work arriving later should be ignored.
+ * Does nothing by default.
+ */
+- (void)doCancelSync;
+
+/**
+ * The time (according to `timeSource`) the current sync has to complete by, if any (see `syncWithTimeout:`),
+ * or 0 otherwise. Handy to set the timeouts of the requests made in `doSync`.
+ */
+@property (nonatomic, readonly) NSTimeInterval syncDeadline;
+
+/**
+ * Subclasses can notify the observers about a change in the object as well.
+ * (This always bumps `changeGeneration`, i.e. is assumed to mean a change in the contents.)
+ */
 - (void)notifyDidChange;
 
 /** Transitions the object into the 'syncing'. */
 - (void)setSyncing;
 
-/** Changes the state to 'failed to sync' and sets an optional error object. */
+/**
+ * Changes the state to 'failed to sync' and sets an optional error object.
+ * (This and `setDidSyncSuccessfully` are ignored after the current sync has timed out, see `syncWithTimeout:`.)
+ */
 - (void)setFailedToSyncWithError:(nullable NSError *)error;
 
 /** Transitions the object into the 'synced successfully' state. */
@@ -82,7 +102,10 @@ NS_ASSUME_NONNULL_BEGIN
 /** Subclasses must override this to return YES when the contents/value of the promise is available. */
 @property (nonatomic, readonly, getter=isContentsAvailable) BOOL isContentsAvailable;
 
-/** Subclasses can notify the observers about a change in the object as well. */
+/**
+ * Subclasses can notify the observers about a change in the object as well.
+ * (This always bumps `changeGeneration`, i.e. is assumed to mean a change in the contents.)
+ */
 - (void)notifyDidChange;
 
 /** @{ */
@@ -106,6 +129,58 @@ NS_ASSUME_NONNULL_BEGIN
 @end
 
 
+/**
+ * Parts of MMMThreadSafeLoadable accessible to subclasses. Everything here can be called from any thread.
+ */
+@interface MMMThreadSafeLoadable (Subclasses)
+
+/** Atomically changes the state bumping `changeGeneration` and notifies the observers. */
+@property (nonatomic, readwrite) MMMLoadableState loadableState;
+
+/** Subclasses must override this to return YES when the contents/value of the promise is available. */
+@property (nonatomic, readonly, getter=isContentsAvailable) BOOL isContentsAvailable;
+
+/** Subclasses might also override this to change when syncIfNeeded triggers sync. */
+- (BOOL)needsSync;
+
+/**
+ * Subclasses must override this to perform the actual synchronization.
+ * This is called on the thread `sync` was called on after the state has been atomically changed to 'syncing'.
+ */
+- (void)doSync;
+
+/**
+ * Subclasses can override this to stop the work started in `doSync`. Called on the thread `cancelSync` was called on,
+ * right before the state is atomically changed from 'syncing' to 'idle'. Does nothing by default.
+ */
+- (void)doCancelSync;
+
+/**
+ * Notifies the observers about a change in the contents of the object that happened without a state transition.
+ * (Transitions notify the observers directly, so overriding this won't catch them.)
+ */
+- (void)notifyDidChange;
+
+/** Transitions the object into the 'syncing'. */
+- (void)setSyncing;
+
+/** Changes the state to 'failed to sync' and sets an optional error object, unless the object has failed already. */
+- (void)setFailedToSyncWithError:(nullable NSError *)error;
+
+/** Transitions the object into the 'synced successfully' state. */
+- (void)setDidSyncSuccessfully;
+
+/** YES, if at least one observer is installed. */
+- (BOOL)hasObservers;
+
+/** Called after the very first observer is added on the thread that has added it. */
+- (void)didAddFirstObserver;
+
+/** Called when the last observer is removed on the thread that has removed it. */
+- (void)didRemoveLastObserver;
+
+@end
+
 //
 //
 //
@@ -65,6 +65,14 @@ typedef NS_CLOSED_ENUM(NSInteger, MMMLoadableState) {
 /** As always, it can be handy to print the current state. */
 extern NSString *NSStringFromMMMLoadableState(MMMLoadableState state);
 
+/** The domain of the errors produced by the loadables themselves rather than by their subclasses. */
+extern NSErrorDomain const MMMLoadableErrorDomain;
+
+typedef NS_ERROR_ENUM(MMMLoadableErrorDomain, MMMLoadableErrorCode) {
+	/** The sync has not completed before its deadline, see `syncWithTimeout:` of `MMMLoadable`. */
+	MMMLoadableErrorSyncTimedOut = 1
+};
+
 @protocol MMMLoadableObserver;
 
 /** 
@@ -121,6 +129,18 @@ NS_SWIFT_NAME(MMMPureLoadableProtocol)
  */
 - (void)removeObserver:(id<MMMLoadableObserver>)observer NS_SWIFT_NAME(removeObserver(_:));
 
+@optional
+
+/**
+ * A number that changes (increases) every time there is an actual change in the loadable, i.e. in its state, error,
+ * or contents, but remains the same for "did change" notifications caused by attempts to set the same state again.
+ *
+ * This allows observers to cheaply skip redundant notifications, see `skipsUnchanged` of `MMMLoadableObserver`.
+ *
+ * All the loadables defined here support it; custom implementations might not.
+ */
+@property (nonatomic, readonly) uint64_t changeGeneration;
+
 @end
 
 /**
@@ -148,6 +168,17 @@ NS_SWIFT_NAME(MMMLoadableProtocol)
 /** Calls `sync` if `needsSync` is YES or if the state is different from 'did sync successfully'. */
 - (void)syncIfNeeded;
 
+@optional
+
+/**
+ * Asks the loadable to stop syncing, e.g. because nobody needs its contents anymore.
+ * The state becomes 'idle' unless the sync completes before it can be cancelled. Ignored when not syncing.
+ *
+ * All the loadables defined here support it (though only those overriding `doCancelSync` stop the actual work);
+ * custom implementations might not, so check with `respondsToSelector:` before calling.
+ */
+- (void)cancelSync;
+
 @end
 
 /** 
@@ -172,6 +203,40 @@ NS_SWIFT_NAME(MMMLoadableObserverProtocol)
 /** A block which is called when a lodable object is changed, see MMMLoadableObserver#loadableDidChange. */
 typedef void (^MMMLoadableObserverDidChangeBlock)(id<MMMPureLoadable> loadable);
 
+/**
+ * Postpones "did change" notifications of all the loadables changed within the given block (the ones based on
+ * `MMMLoadable`, `MMMPureLoadable`, groups, proxies, or `MMMTestLoadable`) till the block returns and then delivers them
+ * at most once per loadable.
+ *
+ * Observers of groups and proxies are notified after the observers of the children, so they see all the changes
+ * at once as well. (A loadable can still be notified again when it is changed by an observer during the delivery.)
+ *
+ * Batches can be nested, the notifications are delivered when the outermost one ends.
+ * Like the rest of the loadables, this is meant to be used on the main thread only.
+ */
+extern void MMMLoadablePerformBatchUpdates(NS_NOESCAPE void (^updates)(void));
+
+/**
+ * Changes in a loadable an instance of `MMMLoadableObserver` can be interested in, see `initWithLoadable:events:...`.
+ */
+typedef NS_OPTIONS(NSUInteger, MMMLoadableObserverEvents) {
+
+	/** The loadable has transitioned into the corresponding state. */
+	MMMLoadableObserverEventBecameIdle = 1 << MMMLoadableStateIdle,
+	MMMLoadableObserverEventBecameSyncing = 1 << MMMLoadableStateSyncing,
+	MMMLoadableObserverEventDidSyncSuccessfully = 1 << MMMLoadableStateDidSyncSuccessfully,
+	MMMLoadableObserverEventDidFailToSync = 1 << MMMLoadableStateDidFailToSync,
+
+	/** `contentsAvailable` has changed from NO to YES or vice versa. */
+	MMMLoadableObserverEventContentsBecameAvailable = 1 << 4,
+	MMMLoadableObserverEventContentsBecameUnavailable = 1 << 5,
+
+	/** "Did change" with neither the state nor `contentsAvailable` changing, i.e. a change in the contents only. */
+	MMMLoadableObserverEventContentsDidChange = 1 << 6,
+
+	MMMLoadableObserverEventAll = (1 << 7) - 1
+};
+
 /** 
  * An proxy that sets itself as an observer of a loadable object and then forwards "did change" notifications
  * to a block or a target/selector pair. This way your custom objects don't have to conform to `MMMLoadableObserver`
@@ -200,14 +265,70 @@ typedef void (^MMMLoadableObserverDidChangeBlock)(id<MMMPureLoadable> loadable);
  */
 - (nullable id)initWithLoadable:(nullable id<MMMPureLoadable>)loadable target:(id<NSObject>)target selector:(SEL)selector;
 
+/**
+ * Similar to `initWithLoadable:block:`, but forwards only notifications corresponding to the given events.
+ *
+ * The events are figured out by comparing the state and `contentsAvailable` of the loadable to the ones seen
+ * during the previous notification (or when the observer is installed), before the block is called.
+ */
+- (nullable id)initWithLoadable:(nullable id<MMMPureLoadable>)loadable
+	events:(MMMLoadableObserverEvents)events
+	block:(MMMLoadableObserverDidChangeBlock)block;
+
+/** Similar to `initWithLoadable:target:selector:`, but forwards only notifications corresponding to the given events. */
+- (nullable id)initWithLoadable:(nullable id<MMMPureLoadable>)loadable
+	events:(MMMLoadableObserverEvents)events
+	target:(id<NSObject>)target
+	selector:(SEL)selector;
+
+/**
+ * Similar to `initWithLoadable:block:`, but calls the block asynchronously on the given queue coalescing all the
+ * notifications that happen before the block gets a chance to run into a single call.
+ *
+ * This allows to move expensive reactions off the notifying thread and to limit the number of calls during bursts.
+ * No call of the block is started after `remove` returns, even if it was scheduled before that. Note that when `remove`
+ * is called on a different queue, then a call that has begun on the target queue already may still be running.
+ * Note that the loadable might be in a different state by the time the block is called.
+ */
+- (nullable id)initWithLoadable:(nullable id<MMMPureLoadable>)loadable
+	queue:(dispatch_queue_t)queue
+	block:(MMMLoadableObserverDidChangeBlock)block;
+
+/** A combination of the above: notifications corresponding to the given events are coalesced on the given queue. */
+- (nullable id)initWithLoadable:(nullable id<MMMPureLoadable>)loadable
+	events:(MMMLoadableObserverEvents)events
+	queue:(dispatch_queue_t)queue
+	block:(MMMLoadableObserverDidChangeBlock)block;
+
 /** 
  * Removes this observer from the associated loadable. It is safe to call it more than once.
  * It's also called automatically when the proxy is deallocated.
  */
 - (void)remove;
 
+/**
+ * When YES, then "did change" notifications that don't change `changeGeneration` of the loadable
+ * (as compared to the value seen during the previous notification or when this is enabled) are not forwarded.
+ *
+ * NO by default. Has no effect for loadables not supporting `changeGeneration`.
+ */
+@property (nonatomic, readwrite) BOOL skipsUnchanged;
+
 @end
 
+/** How old the contents of a loadable are relative to its `maxAge` and `staleWhileRevalidate` settings. */
+typedef NS_ENUM(NSInteger, MMMLoadableFreshness) {
+
+	/** Synced successfully no longer than `maxAge` ago (or `maxAge` is not used). */
+	MMMLoadableFreshnessFresh,
+
+	/** Older than `maxAge`, but still can be shown while a refresh is in progress. */
+	MMMLoadableFreshnessStale,
+
+	/** Older than `maxAge + staleWhileRevalidate` or never synced: better not to show without waiting for a refresh. */
+	MMMLoadableFreshnessExpired
+};
+
 /** 
  * An implementation of a lodable that might be used as a base.
  * Subclasses must override 'isContentsAvailable' and 'doSync', the latter being called from implementation
@@ -219,6 +340,67 @@ typedef void (^MMMLoadableObserverDidChangeBlock)(id<MMMPureLoadable> loadable);
 
 - (id)init NS_DESIGNATED_INITIALIZER;
 
+/**
+ * Same as `sync`, but the sync fails with `MMMLoadableErrorSyncTimedOut` if not completed within the given number
+ * of seconds. The work is cancelled (see `doCancelSync`) and its late completion is ignored in this case.
+ * 0 or a negative value means no deadline.
+ */
+- (void)syncWithTimeout:(NSTimeInterval)timeout;
+
+/** The timeout `sync` (and thus `syncIfNeeded`) uses, see `syncWithTimeout:`. 0 (no deadline) by default. */
+@property (nonatomic, readwrite) NSTimeInterval syncTimeout;
+
+/**
+ * Fails the current sync if its deadline has passed according to `timeSource`.
+ * This is what the internal timer calls, but can be called directly after moving the time forward in tests.
+ */
+- (void)checkSyncDeadline;
+
+/** @{ */
+
+/**
+ * For how long (in seconds) the contents are considered fresh after a successful sync. While they are,
+ * the default `needsSync` is NO; once they are stale, `syncIfNeeded` begins a refresh keeping the current contents
+ * available meanwhile. (Since `sync` is ignored while syncing, there is at most one refresh at a time.)
+ *
+ * 0 (default) means the age of the contents is not taken into account by `needsSync`.
+ */
+@property (nonatomic, readwrite) NSTimeInterval maxAge;
+
+/**
+ * For how long after becoming stale the contents can still be shown while being refreshed,
+ * see `MMMLoadableFreshnessExpired`. 0 by default.
+ */
+@property (nonatomic, readwrite) NSTimeInterval staleWhileRevalidate;
+
+/** The time (according to `timeSource`) of the last successful sync or 0, if there was none. */
+@property (nonatomic, readonly) NSTimeInterval lastSyncTime;
+
+/** How old the contents are now, see `maxAge`. */
+@property (nonatomic, readonly) MMMLoadableFreshness freshness;
+
+/**
+ * Returns the current time in seconds for `maxAge`, the sync deadlines and friends; `NSProcessInfo.systemUptime` by default.
+ * Can be replaced in tests, e.g. with the one based on `MMMTimeSource`.
+ */
+@property (nonatomic, readwrite, copy, null_resettable) NSTimeInterval (^timeSource)(void);
+
+/** @} */
+
+- (void)cancelSync;
+
+/**
+ * When YES, then the sync in progress is cancelled as soon as the last observer is removed, so nobody waits for it.
+ * NO by default.
+ */
+@property (nonatomic, readwrite) BOOL cancelsSyncWhenUnobserved;
+
+/**
+ * Same as `MMMLoadablePerformBatchUpdates()`: "did change" notifications of this and any other loadable changed within
+ * the block are coalesced and delivered after the block returns.
+ */
+- (void)performBatchUpdates:(NS_NOESCAPE void (^)(void))updates;
+
 @end
 
 /**
@@ -231,6 +413,12 @@ typedef void (^MMMLoadableObserverDidChangeBlock)(id<MMMPureLoadable> loadable);
 
 - (id)init NS_DESIGNATED_INITIALIZER;
 
+/**
+ * Same as `MMMLoadablePerformBatchUpdates()`: "did change" notifications of this and any other loadable changed within
+ * the block are coalesced and delivered after the block returns.
+ */
+- (void)performBatchUpdates:(NS_NOESCAPE void (^)(void))updates;
+
 /** @{ */
 
 /** Again, these are open here and not in a separate header like for `MMMLoadable`, because you never
@@ -251,6 +439,39 @@ typedef void (^MMMLoadableObserverDidChangeBlock)(id<MMMPureLoadable> loadable);
 
 @end
 
+/**
+ * Similar to `MMMLoadable`, but can be synced and can change its state from any thread, so background producers
+ * don't have to hop to the main queue for every transition.
+ *
+ * The state and `changeGeneration` are packed into a single word that is read and updated atomically without locks,
+ * so a consistent pair can be obtained on any thread. Transitions are compare-and-swap based, e.g. only one of
+ * concurrent `sync` calls actually begins syncing.
+ *
+ * Observers are notified on the queues they were added with (the main one for plain `addObserver:`), synchronously
+ * if the change happens on the main thread and the observer has asked for the main queue, asynchronously otherwise.
+ * Observers removed before an asynchronous delivery happens don't receive it.
+ * Like with other loadables, the observers are not retained.
+ *
+ * As with `MMMLoadable`, see `MMMLoadable+Subclasses.h` for the parts to override.
+ */
+@interface MMMThreadSafeLoadable : NSObject <MMMLoadable>
+
+- (id)init NS_DESIGNATED_INITIALIZER;
+
+/** Atomically changes the state from 'syncing' to 'idle', see `cancelSync` in `MMMLoadable`. */
+- (void)cancelSync;
+
+/** When YES, then the sync in progress is cancelled as soon as the last observer is removed. NO by default. */
+@property (atomic, readwrite) BOOL cancelsSyncWhenUnobserved;
+
+/** The current state together with the matching `changeGeneration`, both read atomically. */
+- (MMMLoadableState)loadableStateWithGeneration:(uint64_t *)generation;
+
+/** Adds an observer that should be notified on the given queue. */
+- (void)addObserver:(id<MMMLoadableObserver>)observer queue:(dispatch_queue_t)queue NS_SWIFT_NAME(addObserver(_:queue:));
+
+@end
+
 /** 
  * `MMMLoadable` with simple autorefresh logic.
  * Again, see `MMMLoadable+Subclasses.h` if you want to see how to override things.
@@ -261,6 +482,40 @@ typedef void (^MMMLoadableObserverDidChangeBlock)(id<MMMPureLoadable> loadable);
 
 @end
 
+/** A pending autosync scheduled with `MMMAutosyncScheduler`. */
+@interface MMMAutosyncTimerEntry : NSObject
+@end
+
+/**
+ * Drives the autosync timers of all `MMMAutosyncLoadable` objects using a single timer.
+ * Not needed directly normally, public so the scheduling can be tested with a custom time source.
+ * Like the rest of the loadables, this is meant to be used on the main thread only.
+ */
+@interface MMMAutosyncScheduler : NSObject
+
+/** The instance used by `MMMAutosyncLoadable`. */
++ (instancetype)shared;
+
+/** A scheduler based on `NSProcessInfo.systemUptime`. */
+- (id)init;
+
+/** A scheduler reading the current time in seconds from the given block. */
+- (id)initWithTimeSource:(NSTimeInterval (^)(void))timeSource NS_DESIGNATED_INITIALIZER;
+
+/** Asks to call the autosync timer of the given loadable after the given number of seconds, rounded up to a second. */
+- (MMMAutosyncTimerEntry *)scheduleTarget:(MMMAutosyncLoadable *)target after:(NSTimeInterval)timeout;
+
+/** Removes the entry returned by `scheduleTarget:after:` unless it has fired already. Nil is OK. */
+- (void)cancel:(nullable MMMAutosyncTimerEntry *)entry;
+
+/**
+ * Fires all the entries that are due according to the time source.
+ * This is what the internal timer calls, but can be called directly after moving the time forward in tests.
+ */
+- (void)fireDueEntries;
+
+@end
+
 /**
  * Defines how sync failures in child loadables of a loadable group affect the sync state of the whole group.
  */
@@ -276,7 +531,21 @@ typedef NS_ENUM(NSInteger, MMMLoadableGroupFailurePolicy) {
      * The whole group never fails to sync, not even when all the loadables within the group fail.
 	 * (In this case it's assumed that the user code will inspect the children and decide what to do.)
      */
-    MMMLoadableGroupFailurePolicyNever
+    MMMLoadableGroupFailurePolicyNever,
+
+    /**
+     * "First success wins": the whole group is synced successfully as soon as any of the loadables is,
+     * and fails only when all of them fail. This is handy for hedged loads from several sources or mirrors,
+     * where the losing loadables are simply ignored.
+     */
+    MMMLoadableGroupFailurePolicyRace,
+
+    /**
+     * "k of n": the whole group is synced successfully as soon as at least `quorum` of the loadables are
+     * and fails as soon as this cannot be reached anymore, i.e. when more than `n - quorum` of them have failed.
+     * Allows to show something once enough of many optional parts are ready without waiting for the slowest of them.
+     */
+    MMMLoadableGroupFailurePolicyQuorum
 };
 
 /** 
@@ -293,7 +562,19 @@ typedef NS_ENUM(NSInteger, MMMLoadableGroupFailurePolicy) {
  * - 'syncing', when at least one of the loadables in the group is still syncing;
  * - 'synced succesfully' otherwise.
  *
- * Regardless of the failure policy 'contentsAvailable' is `YES` when it is `YES` for all the objects in the group.
+ * The loadable state in case of "race" failure policy is:
+ * - 'synced succesfully', when at least one of the loadables in the group is synced successfully (see `raceWinner`);
+ * - 'syncing', when none has synced successfully yet, but at least one is still syncing;
+ * - 'failed to sync', when all the loadables in the group have failed to sync.
+ *
+ * The loadable state in case of "quorum" failure policy is:
+ * - 'synced succesfully', when at least `quorum` of the loadables in the group are synced successfully;
+ * - 'failed to sync', when so many loadables have failed that `quorum` cannot be reached anymore;
+ * - 'syncing', when at least one of the loadables in the group is still syncing otherwise.
+ * ("Race" is the same as "quorum" with `quorum` being 1.)
+ *
+ * Regardless of the failure policy 'contentsAvailable' is `YES` when it is `YES` for all the objects in the group,
+ * except for the "race" and "quorum" policies where it's enough for 1 or `quorum` objects to have contents available.
  *
  * The 'did change' event of the group is called when when the `loadableState` of the whole object changes or
  * when all the objects are loaded, then every time any of the objects emits 'did change'.
@@ -306,8 +587,39 @@ typedef NS_ENUM(NSInteger, MMMLoadableGroupFailurePolicy) {
 /** Convenience initializer using the "strict" failure policy for compatibility with the current code. */
 - (id)initWithLoadables:(nullable NSArray<id<MMMPureLoadable>> *)loadables;
 
+/** Convenience initializer using the "quorum" failure policy with the given `quorum`. */
+- (id)initWithLoadables:(nullable NSArray<id<MMMPureLoadable>> *)loadables quorum:(NSInteger)quorum;
+
 - (id)init NS_UNAVAILABLE;
 
+/**
+ * The number of loadables that have to sync successfully for the whole group to be synced successfully
+ * when the "quorum" failure policy is used.
+ *
+ * Values less than 1 or greater than the number of loadables are clamped, so 0 (default) means "all of them".
+ */
+@property (nonatomic, readwrite) NSInteger quorum;
+
+/**
+ * The loadables of the group that have failed to sync (as of their last "did change"), in the order they've failed,
+ * every loadable listed once. This is tracked as the children change, so it's cheap to ask for.
+ *
+ * Note that `error` of the group is based on the error of the first of them.
+ */
+@property (nonatomic, readonly) NSArray<id<MMMPureLoadable>> *failedLoadables;
+
+/**
+ * The first of the loadables (in the order of `loadables`) that is synced successfully now.
+ * The contents should be taken from it when the group uses the "race" failure policy.
+ */
+@property (nonatomic, readonly, nullable) id<MMMPureLoadable> raceWinner;
+
+/**
+ * Same as `MMMLoadablePerformBatchUpdates()`: "did change" notifications of this and any other loadable changed within
+ * the block are coalesced and delivered after the block returns.
+ */
+- (void)performBatchUpdates:(NS_NOESCAPE void (^)(void))updates;
+
 @end
 
 /**
@@ -319,7 +631,8 @@ typedef NS_ENUM(NSInteger, MMMLoadableGroupFailurePolicy) {
  * - `needsSync` is YES, if the same property is YES for at least one object in the group;
  * - `sync` and `syncIfNeeded` methods call the corresponding methods of every object in the group supporting them
  *   (note that some time before we required all objects in a "non-pure" group to support syncing, but it's not the case
- *   anymore).
+ *   anymore); this can be limited to a number of children at a time, see `maxConcurrentSyncs`;
+ * - `cancelSync` cancels the children supporting it and drops the ones waiting for their turn to sync.
  */
 @interface MMMLoadableGroup : MMMPureLoadableGroup <MMMLoadable>
 
@@ -329,6 +642,41 @@ typedef NS_ENUM(NSInteger, MMMLoadableGroupFailurePolicy) {
 /** Convenience initializer using the "strict" failure policy for compatibility with the current code. */
 - (id)initWithLoadables:(nullable NSArray<id<MMMPureLoadable>> *)loadables;
 
+/** Convenience initializer using the "quorum" failure policy with the given `quorum`. */
+- (id)initWithLoadables:(nullable NSArray<id<MMMPureLoadable>> *)loadables quorum:(NSInteger)quorum;
+
+/**
+ * The maximum number of children `sync` and `syncIfNeeded` let sync at the same time. The rest are started one by one
+ * as the ones in flight leave the 'syncing' state.
+ *
+ * 0 (default) means no limit, i.e. all the children are asked to sync at once.
+ */
+@property (nonatomic, readwrite) NSInteger maxConcurrentSyncs;
+
+/**
+ * Optional order in which the children are started when `maxConcurrentSyncs` is limited, e.g. to sync the ones
+ * visible to the user first. The order of `loadables` is used by default or for children comparing as equal.
+ */
+@property (nonatomic, readwrite, copy, nullable) NSComparisonResult (^syncOrder)(id<MMMLoadable> a, id<MMMLoadable> b);
+
+/**
+ * Calls `sync` only for the children that have failed to sync (see `failedLoadables`) and support syncing,
+ * leaving the ones that are fine alone. Handy after a partial outage in a large group.
+ * Respects `maxConcurrentSyncs` the same way `sync` does.
+ */
+- (void)syncFailed;
+
+- (void)cancelSync;
+
+/**
+ * When YES and the group uses the "race" or "quorum" failure policy, then the children that are still syncing
+ * are cancelled as soon as enough of them have synced successfully. NO by default, as the children might be shared.
+ *
+ * The cancellation happens asynchronously on the main queue, i.e. after everyone has been notified about the change
+ * in the child that has decided the race; the children waiting for their turn are not started meanwhile though.
+ */
+@property (nonatomic, readwrite) BOOL cancelsLosers;
+
 @end
 
 /**
@@ -358,6 +706,46 @@ typedef NS_ENUM(NSInteger, MMMLoadableGroupFailurePolicy) {
 
 @end
 
+/**
+ * Helps to avoid several loadables doing the same work, e.g. downloading the same image for different screens.
+ *
+ * Loadables are registered under a key (a URL, an ID of a resource, etc) and the live instance is returned for the key
+ * for as long as somebody is using it, i.e. even if it's been evicted from the optional strong `cache` already.
+ * Since a loadable ignores `sync` while it's syncing, the callers sharing an instance share the in-flight sync as well.
+ *
+ * Unlike the rest of the loadables this one can be used from any thread.
+ */
+@interface MMMLoadableRegistry<KeyType, ObjectType> : NSObject
+
+/**
+ * The cache (if any) is used to keep recently registered loadables alive even when nobody holds them,
+ * so they don't have to sync again when needed soon. Feel free to tune its limits, but update the costs of the objects
+ * via `setCost:forKey:`, so they are kept when the objects are put back into the cache after being evicted.
+ */
+- (id)initWithCache:(nullable NSCache<KeyType, ObjectType> *)cache NS_DESIGNATED_INITIALIZER;
+
+/** A registry without a strong cache: loadables live only while they are used. */
+- (id)init;
+
+@property (nonatomic, readonly, nullable) NSCache<KeyType, ObjectType> *cache;
+
+/** The loadable registered for the given key, if it's still alive. */
+- (nullable ObjectType)loadableForKey:(KeyType)key;
+
+/** The loadable registered for the given key, if it's still alive; otherwise the one returned by the factory, which is then registered. */
+- (ObjectType)loadableForKey:(KeyType)key factory:(NS_NOESCAPE ObjectType (^)(void))factory;
+
+/** Registers the given loadable for the key replacing the current one, if any. */
+- (void)setLoadable:(ObjectType)loadable forKey:(KeyType)key;
+
+/** Updates the cost of the loadable registered for the key (if it's still alive) in the cache. */
+- (void)setCost:(NSUInteger)cost forKey:(KeyType)key;
+
+/** The number of keys the registry tracks, including the ones of dead loadables not purged yet. For tests. */
+@property (nonatomic, readonly) NSUInteger entryCount;
+
+@end
+
 /**
  * Can be used as a base for unit test (view) models conforming to MMMLoadable.
  * Basically allows to override properties of MMMLoadable from the outside (i.e. from a unit test).
@@ -399,6 +787,7 @@ typedef NS_ENUM(NSInteger, MMMLoadableGroupFailurePolicy) {
 
 @property (nonatomic, readonly) NSInteger syncIfNeededCounter;
 @property (nonatomic, readonly) NSInteger syncCounter;
+@property (nonatomic, readonly) NSInteger cancelSyncCounter;
 @property (nonatomic, readonly) NSInteger isContentsAvailableCounter;
 
 @property (nonatomic, readonly) NSInteger addObserverCounter;
@@ -409,6 +798,9 @@ typedef NS_ENUM(NSInteger, MMMLoadableGroupFailurePolicy) {
 /** Subclasses can override to perform sync. Does nothing by default. */
 - (void)doSync;
 
+/** Counts the call and changes the state from 'syncing' to 'idle'. */
+- (void)cancelSync;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -6,6 +6,9 @@
 #import "MMMLoadable.h"
 #import "MMMLoadable+Subclasses.h"
 
+#import <os/lock.h>
+#import <stdatomic.h>
+
 #if SWIFT_PACKAGE
 #import "MMMCommonCoreObjC.h"
 #import "UIKit/UIKit.h"
@@ -15,6 +18,8 @@
 
 #pragma mark - MMMLoadable
 
+NSErrorDomain const MMMLoadableErrorDomain = @"MMMLoadable";
+
 NSString *NSStringFromMMMLoadableState(MMMLoadableState state) {
 	MMM_ENUM_NAME_BEGIN(MMMLoadableState, state)
 		MMM_ENUM_CASE(MMMLoadableStateIdle)
@@ -24,33 +29,245 @@ NSString *NSStringFromMMMLoadableState(MMMLoadableState state) {
 	MMM_ENUM_NAME_END()
 }
 
+#pragma mark - Observer list
+
+// Most loadables have no more than a couple of observers, so this many are kept right in the object.
+#define MMM_LOADABLE_OBSERVER_LIST_INLINE_COUNT 2
+
 //
+// A list of observers used by our loadables instead of MMMObserverHub, so nothing is allocated until there are
+// more than `MMM_LOADABLE_OBSERVER_LIST_INLINE_COUNT` of them.
 //
+// Like with the hub the observers are not retained (they must be removed before they go away), which also allows
+// proxies to observe their targets without retain cycles and to remove themselves in `dealloc`.
 //
-@interface MMMLoadable ()
+// Observers can be added or removed while being notified: the removed ones are not called anymore and the added ones
+// are called starting from the next notification only.
+//
+typedef struct {
+	id<MMMLoadableObserver> __unsafe_unretained inlineObservers[MMM_LOADABLE_OBSERVER_LIST_INLINE_COUNT];
+	// The rest of the observers, allocated only when the inline ones are not enough.
+	id<MMMLoadableObserver> __unsafe_unretained *moreObservers;
+	NSUInteger moreCapacity;
+	// The number of used slots, including the ones cleared while notifying.
+	NSUInteger count;
+	// The number of observers actually installed.
+	NSUInteger liveCount;
+	// Slots are only cleared but not reused while this is non-zero.
+	NSUInteger notifyDepth;
+} MMMLoadableObserverList;
+
+static inline id<MMMLoadableObserver> __unsafe_unretained *MMMLoadableObserverListSlot(
+	MMMLoadableObserverList *list, NSUInteger index
+) {
+	return index < MMM_LOADABLE_OBSERVER_LIST_INLINE_COUNT
+		? &list->inlineObservers[index]
+		: &list->moreObservers[index - MMM_LOADABLE_OBSERVER_LIST_INLINE_COUNT];
+}
+
+static inline BOOL MMMLoadableObserverListIsEmpty(MMMLoadableObserverList *list) {
+	return list->liveCount == 0;
+}
+
+static void MMMLoadableObserverListAdd(MMMLoadableObserverList *list, id<MMMLoadableObserver> observer) {
+
+	if (list->count >= MMM_LOADABLE_OBSERVER_LIST_INLINE_COUNT) {
+		NSUInteger moreCount = list->count - MMM_LOADABLE_OBSERVER_LIST_INLINE_COUNT + 1;
+		if (moreCount > list->moreCapacity) {
+			list->moreCapacity = MAX(4, list->moreCapacity * 2);
+			list->moreObservers = (id<MMMLoadableObserver> __unsafe_unretained *)realloc(
+				list->moreObservers,
+				list->moreCapacity * sizeof(id)
+			);
+		}
+	}
+
+	*MMMLoadableObserverListSlot(list, list->count++) = observer;
+	list->liveCount++;
+}
+
+static void MMMLoadableObserverListCompact(MMMLoadableObserverList *list) {
+	NSUInteger j = 0;
+	for (NSUInteger i = 0; i < list->count; i++) {
+		id<MMMLoadableObserver> __unsafe_unretained observer = *MMMLoadableObserverListSlot(list, i);
+		if (observer)
+			*MMMLoadableObserverListSlot(list, j++) = observer;
+	}
+	list->count = j;
+}
+
+/// YES, if the observer was found and removed.
+static BOOL MMMLoadableObserverListRemove(MMMLoadableObserverList *list, id<MMMLoadableObserver> observer) {
+
+	for (NSUInteger i = 0; i < list->count; i++) {
+		id<MMMLoadableObserver> __unsafe_unretained *slot = MMMLoadableObserverListSlot(list, i);
+		if (*slot == observer) {
+			*slot = nil;
+			list->liveCount--;
+			if (list->notifyDepth == 0)
+				MMMLoadableObserverListCompact(list);
+			return YES;
+		}
+	}
+
+	return NO;
+}
+
+static void MMMLoadableObserverListNotify(MMMLoadableObserverList *list, id<MMMPureLoadable> loadable) {
+
+	list->notifyDepth++;
+
+	// Observers added while notifying are placed after this.
+	NSUInteger count = list->count;
+	for (NSUInteger i = 0; i < count; i++) {
+		// Can be nil if removed while notifying. Strong, so it stays alive during the call.
+		id<MMMLoadableObserver> observer = *MMMLoadableObserverListSlot(list, i);
+		[observer loadableDidChange:loadable];
+	}
+
+	if (--list->notifyDepth == 0 && list->count != list->liveCount)
+		MMMLoadableObserverListCompact(list);
+}
+
+/// Moves all the observers into the given hub, leaving the list empty.
+static void MMMLoadableObserverListMoveToHub(MMMLoadableObserverList *list, MMMObserverHub *hub) {
+	NSCAssert(list->notifyDepth == 0, @"Cannot move observers while notifying them");
+	for (NSUInteger i = 0; i < list->count; i++) {
+		id<MMMLoadableObserver> observer = *MMMLoadableObserverListSlot(list, i);
+		if (observer)
+			[hub addObserver:observer];
+		*MMMLoadableObserverListSlot(list, i) = nil;
+	}
+	list->count = 0;
+	list->liveCount = 0;
+}
+
+static void MMMLoadableObserverListFree(MMMLoadableObserverList *list) {
+	free(list->moreObservers);
+	list->moreObservers = NULL;
+	list->moreCapacity = 0;
+}
+
+#pragma mark - Batch updates
+
+/// Implemented by all our loadables, so the batch can deliver the postponed notifications.
+@protocol MMMLoadableBatchable <NSObject>
+/// Notifies the observers of the loadable unconditionally.
+- (void)MMMLoadable_notifyObservers;
+@end
+
+// Like everything else here batches are supposed to be used on the main thread only, so no locking.
+static NSInteger MMMLoadableBatchDepth = 0;
+static NSMutableOrderedSet<id<MMMLoadableBatchable>> *MMMLoadableBatchPending = nil;
+
+/// YES, if a batch is in progress and the notification from the given loadable has been postponed till its end.
+static BOOL MMMLoadableBatchDefer(id<MMMLoadableBatchable> loadable) {
+	if (MMMLoadableBatchDepth == 0)
+		return NO;
+	[MMMLoadableBatchPending addObject:loadable];
+	return YES;
+}
+
+void MMMLoadablePerformBatchUpdates(NS_NOESCAPE void (^updates)(void)) {
+
+	NSCAssert([NSThread isMainThread], @"Batch updates are supported on the main thread only");
+
+	if (MMMLoadableBatchDepth++ == 0 && !MMMLoadableBatchPending)
+		MMMLoadableBatchPending = [[NSMutableOrderedSet alloc] init];
+
+	updates();
+
+	if (MMMLoadableBatchDepth == 1) {
+		// Still deferring while delivering, so the changes caused by the observers (a group reacting to its children,
+		// for example) are coalesced as well. They are delivered in the next round.
+		while (MMMLoadableBatchPending.count > 0) {
+			NSOrderedSet<id<MMMLoadableBatchable>> *pending = MMMLoadableBatchPending;
+			MMMLoadableBatchPending = [[NSMutableOrderedSet alloc] init];
+			for (id<MMMLoadableBatchable> loadable in pending) {
+				[loadable MMMLoadable_notifyObservers];
+			}
+		}
+	}
+
+	MMMLoadableBatchDepth--;
+}
+
+//
+//
+//
+@interface MMMLoadable () <MMMLoadableBatchable>
 @property (nonatomic, readwrite) MMMLoadableState loadableState;
 @property (nonatomic, readwrite) NSError *error;
+/// Sends "did change" without bumping `changeGeneration`.
+- (void)MMMLoadable_notifyDidChangeUnchanged;
+/// Sets the state and sends "did change" bumping `changeGeneration` even if the state remains the same.
+- (void)MMMLoadable_setLoadableStateForcingChange:(MMMLoadableState)loadableState;
 @end
 
 @implementation MMMLoadable {
+	MMMLoadableObserverList _observers;
+	// Created only when a subclass asks for it, see `observerHub`.
 	MMMObserverHub<id<MMMLoadableObserver>> *_observerHub;
+	uint64_t _changeGeneration;
+	// YES, if the next `notifyDidChange` should not bump `_changeGeneration`.
+	BOOL _unchanged;
+	// Changes with every sync, so the deadline of an earlier one can be told apart.
+	NSUInteger _syncID;
+	// YES, after the current sync has timed out, so its late completion is ignored.
+	BOOL _syncTimedOut;
+	NSTimeInterval _syncDeadline;
+	// YES, once a sync has completed successfully, i.e. `_lastSyncTime` is valid. (The time source can return 0.)
+	BOOL _hasSynced;
 }
 
+@synthesize timeSource = _timeSource;
+
 - (id)init {
-	if (self = [super init]) {
-		_observerHub = [[MMMObserverHub alloc] initWithObservable:self];
-	}
-	return self;
+	return [super init];
+}
+
+- (void)dealloc {
+	MMMLoadableObserverListFree(&_observers);
 }
 
 - (void)setLoadableState:(MMMLoadableState)loadableState {
+
+	if (_syncTimedOut) {
+		if (loadableState == MMMLoadableStateDidSyncSuccessfully || loadableState == MMMLoadableStateDidFailToSync) {
+			// A late completion of the sync that has timed out.
+			return;
+		}
+		_syncTimedOut = NO;
+	}
+
+	// Only when a sync actually completes, not when 'did sync successfully' is repeated to signal other changes.
+	if (_loadableState == MMMLoadableStateSyncing && loadableState == MMMLoadableStateDidSyncSuccessfully) {
+		_lastSyncTime = self.timeSource();
+		_hasSynced = YES;
+	}
+
 	// Note that we do not check if the state is the same and notify the observers anyway.
 	// This is handy when we are already in 'did load' state and want to communicate changes in the contents
 	// happening without transitions between loadable states.
+	// The generation is not bumped though when it's clear nothing has changed: the state is the same and it's not
+	// 'did sync successfully' (by our contract `contentsAvailable` and `error` change only together with the state).
+	if (_loadableState == loadableState && loadableState != MMMLoadableStateDidSyncSuccessfully) {
+		[self MMMLoadable_notifyDidChangeUnchanged];
+	} else {
+		_loadableState = loadableState;
+		[self notifyDidChange];
+	}
+}
+
+- (void)MMMLoadable_setLoadableStateForcingChange:(MMMLoadableState)loadableState {
 	_loadableState = loadableState;
 	[self notifyDidChange];
 }
 
+- (uint64_t)changeGeneration {
+	return _changeGeneration;
+}
+
 - (void)setSyncing {
 	self.loadableState = MMMLoadableStateSyncing;
 }
@@ -63,6 +280,8 @@ NSString *NSStringFromMMMLoadableState(MMMLoadableState state) {
 }
 
 - (void)setDidSyncSuccessfully {
+	if (_syncTimedOut)
+		return;
 	_error = nil;
 	self.loadableState = MMMLoadableStateDidSyncSuccessfully;
 }
@@ -73,6 +292,10 @@ NSString *NSStringFromMMMLoadableState(MMMLoadableState state) {
 }
 
 - (void)sync {
+	[self syncWithTimeout:_syncTimeout];
+}
+
+- (void)syncWithTimeout:(NSTimeInterval)timeout {
 
 	if (self.loadableState == MMMLoadableStateSyncing) {
 		// Syncing is in progress already, ignoring the new request
@@ -84,11 +307,116 @@ NSString *NSStringFromMMMLoadableState(MMMLoadableState state) {
 	// or `setDidSyncSuccessfully:`.
 	_error = nil;
 
+	NSUInteger syncID = ++_syncID;
+	if (timeout > 0) {
+		// The same clock as the freshness, so both can be moved forward together in tests.
+		_syncDeadline = self.timeSource() + timeout;
+		[self MMMLoadable_armSyncDeadlineTimer:syncID after:timeout];
+	} else {
+		_syncDeadline = 0;
+	}
+
 	self.loadableState = MMMLoadableStateSyncing;
 
 	[self doSync];
 }
 
+- (void)MMMLoadable_armSyncDeadlineTimer:(NSUInteger)syncID after:(NSTimeInterval)timeout {
+	__weak MMMLoadable *weakSelf = self;
+	dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(timeout * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+		[weakSelf MMMLoadable_syncDeadlineTimerDidFire:syncID];
+	});
+}
+
+- (void)MMMLoadable_syncDeadlineTimerDidFire:(NSUInteger)syncID {
+
+	if (syncID != _syncID || self.loadableState != MMMLoadableStateSyncing)
+		return;
+
+	// The time source does not have to follow the real time, so the deadline might be still ahead.
+	NSTimeInterval remaining = _syncDeadline - self.timeSource();
+	if (remaining > 0) {
+		[self MMMLoadable_armSyncDeadlineTimer:syncID after:remaining];
+		return;
+	}
+
+	[self MMMLoadable_syncDeadlineDidPass];
+}
+
+- (void)checkSyncDeadline {
+	if (_syncDeadline > 0 && self.loadableState == MMMLoadableStateSyncing && self.timeSource() >= _syncDeadline)
+		[self MMMLoadable_syncDeadlineDidPass];
+}
+
+- (void)MMMLoadable_syncDeadlineDidPass {
+
+	NSUInteger syncID = _syncID;
+
+	[self doCancelSync];
+
+	// Unless the subclass has managed to complete it while being cancelled.
+	if (self.loadableState != MMMLoadableStateSyncing)
+		return;
+
+	[self setFailedToSyncWithError:[NSError
+		errorWithDomain:MMMLoadableErrorDomain
+		code:MMMLoadableErrorSyncTimedOut
+		userInfo:@{ NSLocalizedDescriptionKey : @"The sync has not completed in time" }
+	]];
+
+	// Unless one of the observers has started a new sync already.
+	if (syncID == _syncID && self.loadableState == MMMLoadableStateDidFailToSync)
+		_syncTimedOut = YES;
+}
+
+- (NSTimeInterval)syncDeadline {
+	return _syncDeadline;
+}
+
+#pragma mark - Freshness
+
+- (NSTimeInterval (^)(void))timeSource {
+	if (!_timeSource) {
+		_timeSource = ^NSTimeInterval{
+			return [NSProcessInfo processInfo].systemUptime;
+		};
+	}
+	return _timeSource;
+}
+
+- (void)setTimeSource:(NSTimeInterval (^)(void))timeSource {
+	_timeSource = [timeSource copy];
+}
+
+- (MMMLoadableFreshness)freshness {
+
+	if (!_hasSynced)
+		return MMMLoadableFreshnessExpired;
+
+	if (_maxAge <= 0)
+		return MMMLoadableFreshnessFresh;
+
+	NSTimeInterval age = self.timeSource() - _lastSyncTime;
+	if (age < _maxAge)
+		return MMMLoadableFreshnessFresh;
+	else if (age < _maxAge + _staleWhileRevalidate)
+		return MMMLoadableFreshnessStale;
+	else
+		return MMMLoadableFreshnessExpired;
+}
+
+- (void)cancelSync {
+
+	if (self.loadableState != MMMLoadableStateSyncing)
+		return;
+
+	[self doCancelSync];
+
+	// Unless the subclass has managed to complete the sync or has changed the state in some other way.
+	if (self.loadableState == MMMLoadableStateSyncing)
+		self.loadableState = MMMLoadableStateIdle;
+}
+
 #pragma mark - Overridables
 
 - (BOOL)isContentsAvailable {
@@ -98,21 +426,31 @@ NSString *NSStringFromMMMLoadableState(MMMLoadableState state) {
 - (BOOL)needsSync {
 	return !self.contentsAvailable
 		|| (self.loadableState == MMMLoadableStateDidFailToSync)
-		|| (self.loadableState == MMMLoadableStateIdle);
+		|| (self.loadableState == MMMLoadableStateIdle)
+		|| (_maxAge > 0 && self.freshness != MMMLoadableFreshnessFresh);
 }
 
 - (void)doSync {
 	MMM_MUST_BE_IMPLEMENTED();
 }
 
+- (void)doCancelSync {
+	// Nothing to stop by default, the late results should be ignored by the subclass.
+}
+
 #pragma mark -
 
-- (MMMObserverHub *)observerHub {
+- (MMMObserverHub<id<MMMLoadableObserver>> *)observerHub {
+	if (!_observerHub) {
+		// The hub is created only for subclasses that need it and then it's used for all the observers.
+		_observerHub = [[MMMObserverHub alloc] initWithObservable:self];
+		MMMLoadableObserverListMoveToHub(&_observers, _observerHub);
+	}
 	return _observerHub;
 }
 
 - (BOOL)hasObservers {
-	return !_observerHub.empty;
+	return _observerHub ? !_observerHub.empty : !MMMLoadableObserverListIsEmpty(&_observers);
 }
 
 - (void)didAddFirstObserver {
@@ -125,155 +463,782 @@ NSString *NSStringFromMMMLoadableState(MMMLoadableState state) {
 
 - (void)addObserver:(id<MMMLoadableObserver>)observer {
 
-	BOOL wasEmpty = [_observerHub isEmpty];
+	BOOL wasEmpty = ![self hasObservers];
 
-	[_observerHub addObserver:observer];
+	if (_observerHub)
+		[_observerHub addObserver:observer];
+	else
+		MMMLoadableObserverListAdd(&_observers, observer);
 
 	if (wasEmpty) {
-		NSAssert(![_observerHub isEmpty], @"");
+		NSAssert([self hasObservers], @"");
 		[self didAddFirstObserver];
 	}
 }
 
 - (void)removeObserver:(id<MMMLoadableObserver>)observer {
 
-	if ([_observerHub removeObserver:observer] && [_observerHub isEmpty])
+	BOOL removed = _observerHub
+		? [_observerHub removeObserver:observer]
+		: MMMLoadableObserverListRemove(&_observers, observer);
+
+	if (removed && ![self hasObservers]) {
 		[self didRemoveLastObserver];
+		if (_cancelsSyncWhenUnobserved)
+			[self cancelSync];
+	}
+}
+
+- (void)performBatchUpdates:(NS_NOESCAPE void (^)(void))updates {
+	MMMLoadablePerformBatchUpdates(updates);
+}
+
+- (void)notifyDidChange {
+
+	// Every explicit notification is assumed to mean a change in the contents.
+	if (_unchanged)
+		_unchanged = NO;
+	else
+		_changeGeneration++;
+
+	if (MMMLoadableBatchDefer(self))
+		return;
+	[self MMMLoadable_notifyObservers];
 }
 
-- (void)notifyDidChange {
-	[_observerHub forEachObserver:^(id<MMMLoadableObserver> observer) {
-		[observer loadableDidChange:self];
-	}];
+- (void)MMMLoadable_notifyDidChangeUnchanged {
+	_unchanged = YES;
+	[self notifyDidChange];
+}
+
+- (void)MMMLoadable_notifyObservers {
+	if (_observerHub) {
+		[_observerHub forEachObserver:^(id<MMMLoadableObserver> observer) {
+			[observer loadableDidChange:self];
+		}];
+	} else {
+		MMMLoadableObserverListNotify(&_observers, self);
+	}
+}
+
+- (NSString *)debugDescription {
+	return [NSString stringWithFormat:@"<%@: %p; %@, contents available: %d, needs sync: %d>",
+		self.class,
+		self,
+		NSStringFromMMMLoadableState(self.loadableState),
+		self.contentsAvailable,
+		self.needsSync
+	];
+}
+
+- (NSString *)description {
+	return [NSString stringWithFormat:@"<%@: %@, contents available: %d, needs sync: %d>",
+		self.class,
+		NSStringFromMMMLoadableState(self.loadableState),
+		self.contentsAvailable,
+		self.needsSync
+	];
+}
+
+@end
+
+//
+// Note that I don't want to inherit MMMLoadable from this class, so the implementation is duplicated.
+//
+@interface MMMPureLoadable () <MMMLoadableBatchable>
+@property (nonatomic, readwrite) MMMLoadableState loadableState;
+@property (nonatomic, readwrite) NSError *error;
+/// Sends "did change" without bumping `changeGeneration`.
+- (void)MMMLoadable_notifyDidChangeUnchanged;
+/// Sets the state and sends "did change" bumping `changeGeneration` even if the state remains the same.
+- (void)MMMLoadable_setLoadableStateForcingChange:(MMMLoadableState)loadableState;
+@end
+
+@implementation MMMPureLoadable {
+	MMMLoadableObserverList _observers;
+	// Created only when a subclass asks for it, see `observerHub`.
+	MMMObserverHub<id<MMMLoadableObserver>> *_observerHub;
+	uint64_t _changeGeneration;
+	// YES, if the next `notifyDidChange` should not bump `_changeGeneration`.
+	BOOL _unchanged;
+}
+
+- (id)init {
+	return [super init];
+}
+
+- (void)dealloc {
+	MMMLoadableObserverListFree(&_observers);
+}
+
+- (void)setLoadableState:(MMMLoadableState)loadableState {
+	// Note that we do not check if the state is the same and notify the observers anyway.
+	// This is handy when we are already in 'did load' state and want to communicate changes in the contents
+	// happening without transitions between loadable states.
+	// The generation is not bumped though when it's clear nothing has changed: the state is the same and it's not
+	// 'did sync successfully' (by our contract `contentsAvailable` and `error` change only together with the state).
+	if (_loadableState == loadableState && loadableState != MMMLoadableStateDidSyncSuccessfully) {
+		[self MMMLoadable_notifyDidChangeUnchanged];
+	} else {
+		_loadableState = loadableState;
+		[self notifyDidChange];
+	}
+}
+
+- (void)MMMLoadable_setLoadableStateForcingChange:(MMMLoadableState)loadableState {
+	_loadableState = loadableState;
+	[self notifyDidChange];
+}
+
+- (uint64_t)changeGeneration {
+	return _changeGeneration;
+}
+
+- (void)setSyncing {
+	self.loadableState = MMMLoadableStateSyncing;
+}
+
+- (void)setFailedToSyncWithError:(NSError *)error {
+	if (_loadableState != MMMLoadableStateDidFailToSync) {
+		_error = error;
+		self.loadableState = MMMLoadableStateDidFailToSync;
+	}
+}
+
+- (void)setDidSyncSuccessfully {
+	_error = nil;
+	self.loadableState = MMMLoadableStateDidSyncSuccessfully;
+}
+
+#pragma mark - Overridables
+
+- (BOOL)isContentsAvailable {
+	return NO;
+}
+
+#pragma mark -
+
+- (MMMObserverHub<id<MMMLoadableObserver>> *)observerHub {
+	if (!_observerHub) {
+		// The hub is created only for subclasses that need it and then it's used for all the observers.
+		_observerHub = [[MMMObserverHub alloc] initWithObservable:self];
+		MMMLoadableObserverListMoveToHub(&_observers, _observerHub);
+	}
+	return _observerHub;
+}
+
+- (BOOL)hasObservers {
+	return _observerHub ? !_observerHub.empty : !MMMLoadableObserverListIsEmpty(&_observers);
+}
+
+- (void)didAddFirstObserver {
+	// Nothing to do here, but subclasses can override.
+}
+
+- (void)didRemoveLastObserver {
+	// Nothing to do here, but subclasses can override.
+}
+
+- (void)addObserver:(id<MMMLoadableObserver>)observer {
+
+	BOOL wasEmpty = ![self hasObservers];
+
+	if (_observerHub)
+		[_observerHub addObserver:observer];
+	else
+		MMMLoadableObserverListAdd(&_observers, observer);
+
+	if (wasEmpty) {
+		NSAssert([self hasObservers], @"");
+		[self didAddFirstObserver];
+	}
+}
+
+- (void)removeObserver:(id<MMMLoadableObserver>)observer {
+
+	BOOL removed = _observerHub
+		? [_observerHub removeObserver:observer]
+		: MMMLoadableObserverListRemove(&_observers, observer);
+
+	if (removed && ![self hasObservers])
+		[self didRemoveLastObserver];
+}
+
+- (void)performBatchUpdates:(NS_NOESCAPE void (^)(void))updates {
+	MMMLoadablePerformBatchUpdates(updates);
+}
+
+- (void)notifyDidChange {
+
+	// Every explicit notification is assumed to mean a change in the contents.
+	if (_unchanged)
+		_unchanged = NO;
+	else
+		_changeGeneration++;
+
+	if (MMMLoadableBatchDefer(self))
+		return;
+	[self MMMLoadable_notifyObservers];
+}
+
+- (void)MMMLoadable_notifyDidChangeUnchanged {
+	_unchanged = YES;
+	[self notifyDidChange];
+}
+
+- (void)MMMLoadable_notifyObservers {
+	if (_observerHub) {
+		[_observerHub forEachObserver:^(id<MMMLoadableObserver> observer) {
+			[observer loadableDidChange:self];
+		}];
+	} else {
+		MMMLoadableObserverListNotify(&_observers, self);
+	}
+}
+
+- (NSString *)debugDescription {
+	return [NSString stringWithFormat:@"<%@: %p; %@, contents available: %d>",
+		self.class,
+		self,
+		NSStringFromMMMLoadableState(self.loadableState),
+		self.contentsAvailable
+	];
+}
+
+- (NSString *)description {
+	return [NSString stringWithFormat:@"<%@: %@, contents available: %d>",
+		self.class,
+		NSStringFromMMMLoadableState(self.loadableState),
+		self.contentsAvailable
+	];
+}
+
+@end
+
+//
+//
+//
+@interface MMMThreadSafeLoadableObserver : NSObject
+
+/// Not retained, like with the rest of the loadables; nil when the observer is gone without being removed.
+@property (nonatomic, readonly, weak) id<MMMLoadableObserver> observer;
+
+/// The observer as it was added, for identity checks only. (The weak reference is nil already while the observer
+/// removes itself in `dealloc`.)
+@property (nonatomic, readonly, unsafe_unretained) id<MMMLoadableObserver> observerPointer;
+
+@property (nonatomic, readonly) dispatch_queue_t queue;
+
+/// Set when the observer is removed, so deliveries that are already queued are skipped.
+@property (atomic, readwrite) BOOL removed;
+
+- (id)initWithObserver:(id<MMMLoadableObserver>)observer queue:(dispatch_queue_t)queue NS_DESIGNATED_INITIALIZER;
+- (id)init NS_UNAVAILABLE;
+
+/// Calls the observer unless it has been removed or is gone already.
+- (void)deliverDidChange:(id<MMMPureLoadable>)loadable;
+
+@end
+
+@implementation MMMThreadSafeLoadableObserver
+
+- (id)initWithObserver:(id<MMMLoadableObserver>)observer queue:(dispatch_queue_t)queue {
+	if (self = [super init]) {
+		_observer = observer;
+		_observerPointer = observer;
+		_queue = queue;
+	}
+	return self;
+}
+
+- (void)deliverDidChange:(id<MMMPureLoadable>)loadable {
+	if (self.removed)
+		return;
+	id<MMMLoadableObserver> observer = _observer;
+	if (!observer)
+		return;
+	[observer loadableDidChange:loadable];
+}
+
+@end
+
+// The lower bits of the state word of MMMThreadSafeLoadable hold MMMLoadableState, the rest is the generation.
+static const uint64_t MMMThreadSafeLoadableStateMask = 0x3;
+static const int MMMThreadSafeLoadableGenerationShift = 2;
+
+static inline MMMLoadableState MMMThreadSafeLoadableStateOf(uint64_t word) {
+	return (MMMLoadableState)(word & MMMThreadSafeLoadableStateMask);
+}
+
+static inline uint64_t MMMThreadSafeLoadableNextWord(uint64_t word, MMMLoadableState state) {
+	return (((word >> MMMThreadSafeLoadableGenerationShift) + 1) << MMMThreadSafeLoadableGenerationShift) | (uint64_t)state;
+}
+
+@interface MMMThreadSafeLoadable () <MMMLoadableBatchable>
+@end
+
+@implementation MMMThreadSafeLoadable {
+
+	_Atomic(uint64_t) _stateWord;
+
+	// Protects the error and the list of observers, neither of which is touched on the hot path of reading the state.
+	os_unfair_lock _lock;
+	NSError *_error;
+	// Immutable, replaced as a whole when changed, so the observers can be notified without holding the lock.
+	NSArray<MMMThreadSafeLoadableObserver *> *_observers;
+}
+
+- (id)init {
+	if (self = [super init]) {
+		atomic_init(&_stateWord, (uint64_t)MMMLoadableStateIdle);
+		_lock = OS_UNFAIR_LOCK_INIT;
+		_observers = @[];
+	}
+	return self;
+}
+
+#pragma mark - State
+
+- (MMMLoadableState)loadableState {
+	return MMMThreadSafeLoadableStateOf(atomic_load_explicit(&_stateWord, memory_order_acquire));
+}
+
+- (uint64_t)changeGeneration {
+	return atomic_load_explicit(&_stateWord, memory_order_acquire) >> MMMThreadSafeLoadableGenerationShift;
+}
+
+- (MMMLoadableState)loadableStateWithGeneration:(uint64_t *)generation {
+	uint64_t word = atomic_load_explicit(&_stateWord, memory_order_acquire);
+	if (generation)
+		*generation = word >> MMMThreadSafeLoadableGenerationShift;
+	return MMMThreadSafeLoadableStateOf(word);
+}
+
+/// Atomically changes the state (bumping the generation) unless the current state is `unlessState`;
+/// a negative `unlessState` means "no exception". Returns NO if nothing has been changed.
+- (BOOL)transitionToState:(MMMLoadableState)state unlessState:(NSInteger)unlessState {
+	uint64_t word = atomic_load_explicit(&_stateWord, memory_order_relaxed);
+	do {
+		if (MMMThreadSafeLoadableStateOf(word) == unlessState)
+			return NO;
+	} while (!atomic_compare_exchange_weak_explicit(
+		&_stateWord, &word, MMMThreadSafeLoadableNextWord(word, state),
+		memory_order_acq_rel, memory_order_relaxed
+	));
+	return YES;
+}
+
+/// Same as `transitionToState:unlessState:` but also replaces the error when the state is changed.
+/// Done under the lock, so anyone seeing the new state and then asking for the error gets the matching one,
+/// and the error cannot be overwritten by a concurrent transition in between.
+- (BOOL)transitionToState:(MMMLoadableState)state unlessState:(NSInteger)unlessState error:(NSError *)error {
+	os_unfair_lock_lock(&_lock);
+	BOOL changed = [self transitionToState:state unlessState:unlessState];
+	if (changed)
+		_error = error;
+	os_unfair_lock_unlock(&_lock);
+	return changed;
+}
+
+- (void)setLoadableState:(MMMLoadableState)loadableState {
+	// Like in MMMLoadable the observers are notified even if the state is the same, but the generation is not bumped
+	// unless it can be an actual change ('did sync successfully' again can mean new contents).
+	NSInteger unlessState = (loadableState == MMMLoadableStateDidSyncSuccessfully) ? -1 : loadableState;
+	[self transitionToState:loadableState unlessState:unlessState];
+	[self notifyObservers];
+}
+
+- (NSError *)error {
+	os_unfair_lock_lock(&_lock);
+	NSError *error = _error;
+	os_unfair_lock_unlock(&_lock);
+	return error;
+}
+
+- (void)setError:(NSError *)error {
+	os_unfair_lock_lock(&_lock);
+	_error = error;
+	os_unfair_lock_unlock(&_lock);
+}
+
+- (void)setSyncing {
+	self.loadableState = MMMLoadableStateSyncing;
+}
+
+- (void)setFailedToSyncWithError:(NSError *)error {
+	if ([self transitionToState:MMMLoadableStateDidFailToSync unlessState:MMMLoadableStateDidFailToSync error:error])
+		[self notifyObservers];
+}
+
+- (void)setDidSyncSuccessfully {
+	[self transitionToState:MMMLoadableStateDidSyncSuccessfully unlessState:-1 error:nil];
+	[self notifyObservers];
+}
+
+- (void)syncIfNeeded {
+	if (self.needsSync)
+		[self sync];
+}
+
+- (void)sync {
+
+	// Only one of concurrent calls can win here, the rest are ignored as the syncing is in progress already.
+	if (![self transitionToState:MMMLoadableStateSyncing unlessState:MMMLoadableStateSyncing error:nil])
+		return;
+
+	[self notifyObservers];
+
+	[self doSync];
+}
+
+- (void)cancelSync {
+
+	if (self.loadableState != MMMLoadableStateSyncing)
+		return;
+
+	[self doCancelSync];
+
+	// Only if still syncing, as the sync could complete on another thread meanwhile.
+	uint64_t word = atomic_load_explicit(&_stateWord, memory_order_relaxed);
+	do {
+		if (MMMThreadSafeLoadableStateOf(word) != MMMLoadableStateSyncing)
+			return;
+	} while (!atomic_compare_exchange_weak_explicit(
+		&_stateWord, &word, MMMThreadSafeLoadableNextWord(word, MMMLoadableStateIdle),
+		memory_order_acq_rel, memory_order_relaxed
+	));
+
+	[self notifyObservers];
+}
+
+#pragma mark - Overridables
+
+- (BOOL)isContentsAvailable {
+	return NO;
+}
+
+- (BOOL)needsSync {
+	MMMLoadableState state = self.loadableState;
+	return !self.contentsAvailable
+		|| (state == MMMLoadableStateDidFailToSync)
+		|| (state == MMMLoadableStateIdle);
+}
+
+- (void)doSync {
+	MMM_MUST_BE_IMPLEMENTED();
+}
+
+- (void)doCancelSync {
+	// Nothing to stop by default.
+}
+
+#pragma mark - Observers
+
+- (BOOL)hasObservers {
+	os_unfair_lock_lock(&_lock);
+	BOOL result = _observers.count > 0;
+	os_unfair_lock_unlock(&_lock);
+	return result;
+}
+
+- (void)didAddFirstObserver {
+	// Nothing to do here, but subclasses can override.
+}
+
+- (void)didRemoveLastObserver {
+	// Nothing to do here, but subclasses can override.
+}
+
+- (void)addObserver:(id<MMMLoadableObserver>)observer {
+	[self addObserver:observer queue:dispatch_get_main_queue()];
+}
+
+- (void)addObserver:(id<MMMLoadableObserver>)observer queue:(dispatch_queue_t)queue {
+
+	MMMThreadSafeLoadableObserver *entry = [[MMMThreadSafeLoadableObserver alloc] initWithObserver:observer queue:queue];
+
+	os_unfair_lock_lock(&_lock);
+	BOOL wasEmpty = _observers.count == 0;
+	_observers = [_observers arrayByAddingObject:entry];
+	os_unfair_lock_unlock(&_lock);
+
+	if (wasEmpty)
+		[self didAddFirstObserver];
+}
+
+- (void)removeObserver:(id<MMMLoadableObserver>)observer {
+
+	MMMThreadSafeLoadableObserver *removed = nil;
+	BOOL isEmpty = NO;
+
+	os_unfair_lock_lock(&_lock);
+	NSUInteger index = [_observers indexOfObjectPassingTest:^BOOL(MMMThreadSafeLoadableObserver *e, NSUInteger i, BOOL *stop) {
+		return e.observerPointer == observer;
+	}];
+	if (index != NSNotFound) {
+		removed = _observers[index];
+		NSMutableArray *observers = [_observers mutableCopy];
+		[observers removeObjectAtIndex:index];
+		_observers = observers;
+		isEmpty = observers.count == 0;
+	}
+	os_unfair_lock_unlock(&_lock);
+
+	NSAssert(removed, @"Trying to remove an observer that was not added to %@", self);
+	removed.removed = YES;
+
+	if (removed && isEmpty) {
+		[self didRemoveLastObserver];
+		if (self.cancelsSyncWhenUnobserved)
+			[self cancelSync];
+	}
+}
+
+- (void)notifyDidChange {
+	// Bumping the generation only, the state remains the same.
+	atomic_fetch_add_explicit(&_stateWord, (uint64_t)1 << MMMThreadSafeLoadableGenerationShift, memory_order_acq_rel);
+	[self notifyObservers];
+}
+
+- (void)notifyObservers {
+	// Batches are for the main thread only.
+	if ([NSThread isMainThread] && MMMLoadableBatchDefer(self))
+		return;
+	[self MMMLoadable_notifyObservers];
+}
+
+- (void)MMMLoadable_notifyObservers {
+
+	BOOL isMainThread = [NSThread isMainThread];
+
+	os_unfair_lock_lock(&_lock);
+	NSArray<MMMThreadSafeLoadableObserver *> *observers = _observers;
+	os_unfair_lock_unlock(&_lock);
+
+	dispatch_queue_t mainQueue = dispatch_get_main_queue();
+	for (MMMThreadSafeLoadableObserver *entry in observers) {
+		if (isMainThread && entry.queue == mainQueue) {
+			[entry deliverDidChange:self];
+		} else {
+			dispatch_async(entry.queue, ^{
+				[entry deliverDidChange:self];
+			});
+		}
+	}
 }
 
-- (NSString *)debugDescription {
-	return [NSString stringWithFormat:@"<%@: %p; %@, contents available: %d, needs sync: %d>",
+- (NSString *)description {
+	return [NSString stringWithFormat:@"<%@: %@, contents available: %d>",
 		self.class,
-		self,
 		NSStringFromMMMLoadableState(self.loadableState),
-		self.contentsAvailable,
-		self.needsSync
+		self.contentsAvailable
 	];
 }
 
-- (NSString *)description {
-	return [NSString stringWithFormat:@"<%@: %@, contents available: %d, needs sync: %d>",
-		self.class,
-		NSStringFromMMMLoadableState(self.loadableState),
-		self.contentsAvailable,
-		self.needsSync
-	];
+@end
+
+#pragma mark - MMMAutosyncLoadable
+
+@interface MMMAutosyncTimerEntry () {
+	@package
+	__weak MMMAutosyncLoadable *_target;
+	// The tick of the wheel the entry is due at.
+	int64_t _tick;
+	// The slot of the wheel the entry is in, -1 when it's not scheduled anymore.
+	NSInteger _slot;
 }
+@end
 
+@implementation MMMAutosyncTimerEntry
 @end
 
-//
-// Note that I don't want to inherit MMMLoadable from this class, so the implementation is duplicated.
-//
-@interface MMMPureLoadable ()
-@property (nonatomic, readwrite) MMMLoadableState loadableState;
-@property (nonatomic, readwrite) NSError *error;
+@interface MMMAutosyncLoadable ()
+- (void)autosyncTimer;
 @end
 
-@implementation MMMPureLoadable {
-	MMMObserverHub<id<MMMLoadableObserver>> *_observerHub;
+// The scheduler uses a single `NSTimer` for all the entries.
+//
+// The pending timers are kept in a hashed timing wheel: time is split into ticks of `MMMAutosyncSchedulerTickLength`
+// and every entry lives in the slot corresponding to its tick modulo the number of slots, so scheduling and
+// cancelling are O(1), while the entries due in more than one revolution of the wheel simply wait for their tick.
+// The OS timer is armed for the nearest non-empty tick only, i.e. there are no wakeups every tick.
+//
+// Autosync intervals are in the tens of seconds normally, so firing up to a tick later than asked for is fine.
+//
+static NSTimeInterval const MMMAutosyncSchedulerTickLength = 1;
+static NSInteger const MMMAutosyncSchedulerSlotCount = 64;
+
+@implementation MMMAutosyncScheduler {
+	NSHashTable<MMMAutosyncTimerEntry *> *_slots[MMMAutosyncSchedulerSlotCount];
+	// The earliest tick among the entries of each slot, INT64_MAX for empty slots.
+	int64_t _slotMinTicks[MMMAutosyncSchedulerSlotCount];
+	NSInteger _count;
+	// All the ticks up to this one have been processed.
+	int64_t _processedTick;
+	// The tick the timer is armed for, INT64_MAX when it's not.
+	int64_t _timerTick;
+	NSTimer *_timer;
+	NSTimeInterval (^_timeSource)(void);
+}
+
++ (instancetype)shared {
+	static MMMAutosyncScheduler *shared = nil;
+	static dispatch_once_t onceToken;
+	dispatch_once(&onceToken, ^{
+		shared = [[MMMAutosyncScheduler alloc] init];
+	});
+	return shared;
 }
 
 - (id)init {
+	return [self initWithTimeSource:^NSTimeInterval{
+		// Uptime rather than wall clock time, so changes of the latter don't affect the timers.
+		return [NSProcessInfo processInfo].systemUptime;
+	}];
+}
+
+- (id)initWithTimeSource:(NSTimeInterval (^)(void))timeSource {
 	if (self = [super init]) {
-		_observerHub = [[MMMObserverHub alloc] initWithObservable:self];
+		_timeSource = [timeSource copy];
+		for (NSInteger i = 0; i < MMMAutosyncSchedulerSlotCount; i++) {
+			_slots[i] = [[NSHashTable alloc]
+				initWithOptions:NSPointerFunctionsStrongMemory | NSPointerFunctionsObjectPointerPersonality
+				capacity:0
+			];
+			_slotMinTicks[i] = INT64_MAX;
+		}
+		_processedTick = [self currentTick];
+		_timerTick = INT64_MAX;
 	}
 	return self;
 }
 
-- (void)setLoadableState:(MMMLoadableState)loadableState {
-	// Note that we do not check if the state is the same and notify the observers anyway.
-	// This is handy when we are already in 'did load' state and want to communicate changes in the contents
-	// happening without transitions between loadable states.
-	_loadableState = loadableState;
-	[self notifyDidChange];
+- (int64_t)currentTick {
+	return (int64_t)floor(_timeSource() / MMMAutosyncSchedulerTickLength);
 }
 
-- (void)setSyncing {
-	self.loadableState = MMMLoadableStateSyncing;
-}
+- (MMMAutosyncTimerEntry *)scheduleTarget:(MMMAutosyncLoadable *)target after:(NSTimeInterval)timeout {
 
-- (void)setFailedToSyncWithError:(NSError *)error {
-	if (_loadableState != MMMLoadableStateDidFailToSync) {
-		_error = error;
-		self.loadableState = MMMLoadableStateDidFailToSync;
-	}
-}
+	NSAssert([NSThread isMainThread], @"");
 
-- (void)setDidSyncSuccessfully {
-	_error = nil;
-	self.loadableState = MMMLoadableStateDidSyncSuccessfully;
-}
+	MMMAutosyncTimerEntry *entry = [[MMMAutosyncTimerEntry alloc] init];
+	entry->_target = target;
+	// Rounding up, so the entry is never fired earlier than asked for.
+	entry->_tick = (int64_t)ceil((_timeSource() + timeout) / MMMAutosyncSchedulerTickLength);
+	if (entry->_tick <= _processedTick)
+		entry->_tick = _processedTick + 1;
+	entry->_slot = (NSInteger)(entry->_tick % MMMAutosyncSchedulerSlotCount);
 
-#pragma mark - Overridables
+	[_slots[entry->_slot] addObject:entry];
+	_slotMinTicks[entry->_slot] = MIN(_slotMinTicks[entry->_slot], entry->_tick);
+	_count++;
 
-- (BOOL)isContentsAvailable {
-	return NO;
+	if (entry->_tick < _timerTick)
+		[self armTimerForTick:entry->_tick];
+
+	return entry;
 }
 
-#pragma mark -
+- (void)cancel:(MMMAutosyncTimerEntry *)entry {
 
-- (MMMObserverHub<id<MMMLoadableObserver>> *)observerHub {
-	return _observerHub;
-}
+	if (!entry || entry->_slot < 0)
+		return;
 
-- (BOOL)hasObservers {
-	return !_observerHub.empty;
-}
+	NSInteger slot = entry->_slot;
+	[self removeEntry:entry];
+	if (entry->_tick == _slotMinTicks[slot])
+		[self updateMinTickForSlot:slot];
 
-- (void)didAddFirstObserver {
-	// Nothing to do here, but subclasses can override.
+	// Not touching the timer: it'll fire once for nothing at most, which is cheaper than looking for the next tick now.
+	if (_count == 0)
+		[self armTimerForTick:INT64_MAX];
 }
 
-- (void)didRemoveLastObserver {
-	// Nothing to do here, but subclasses can override.
+- (void)armTimerForTick:(int64_t)tick {
+
+	[_timer invalidate];
+	_timer = nil;
+	_timerTick = tick;
+
+	if (tick == INT64_MAX)
+		return;
+
+	NSTimeInterval timeout = MAX(0, tick * MMMAutosyncSchedulerTickLength - _timeSource());
+	_timer = [NSTimer
+		scheduledTimerWithTimeInterval:timeout
+		target:self
+		selector:@selector(fireDueEntries)
+		userInfo:nil
+		repeats:NO
+	];
+	// Allowing the system to coalesce our wakeups with others.
+	_timer.tolerance = MMMAutosyncSchedulerTickLength;
 }
 
-- (void)addObserver:(id<MMMLoadableObserver>)observer {
+- (void)fireDueEntries {
 
-	BOOL wasEmpty = [_observerHub isEmpty];
+	NSAssert([NSThread isMainThread], @"");
 
-	[_observerHub addObserver:observer];
+	// Can be called directly (in tests) while the timer is still armed.
+	[self armTimerForTick:INT64_MAX];
 
-	if (wasEmpty) {
-		NSAssert(![_observerHub isEmpty], @"");
-		[self didAddFirstObserver];
+	int64_t now = [self currentTick];
+
+	// Collecting everything due first, because the targets are going to schedule new entries while being fired.
+	NSMutableArray<MMMAutosyncTimerEntry *> *due = [[NSMutableArray alloc] init];
+	int64_t from = MAX(_processedTick + 1, now - MMMAutosyncSchedulerSlotCount + 1);
+	for (int64_t tick = from; tick <= now; tick++) {
+		NSInteger slot = (NSInteger)(tick % MMMAutosyncSchedulerSlotCount);
+		if (_slotMinTicks[slot] > now)
+			continue;
+		for (MMMAutosyncTimerEntry *entry in _slots[slot]) {
+			if (entry->_tick <= now)
+				[due addObject:entry];
+		}
 	}
-}
+	_processedTick = now;
 
-- (void)removeObserver:(id<MMMLoadableObserver>)observer {
+	for (MMMAutosyncTimerEntry *entry in due) {
+		[self removeEntry:entry];
+	}
+	// Due entries are the earliest in their slots, so each of these slots needs a new minimum.
+	for (int64_t tick = from; tick <= now; tick++) {
+		NSInteger slot = (NSInteger)(tick % MMMAutosyncSchedulerSlotCount);
+		if (_slotMinTicks[slot] <= now)
+			[self updateMinTickForSlot:slot];
+	}
 
-	if ([_observerHub removeObserver:observer] && [_observerHub isEmpty])
-		[self didRemoveLastObserver];
+	// Arming before firing, so the entries scheduled by the targets only have to compare themselves to the next tick.
+	if (_count > 0)
+		[self armTimerForTick:[self nextTick]];
+
+	for (MMMAutosyncTimerEntry *entry in due) {
+		[entry->_target autosyncTimer];
+	}
 }
 
-- (void)notifyDidChange {
-	[_observerHub forEachObserver:^(id<MMMLoadableObserver> observer) {
-		[observer loadableDidChange:self];
-	}];
+- (void)removeEntry:(MMMAutosyncTimerEntry *)entry {
+	[_slots[entry->_slot] removeObject:entry];
+	entry->_slot = -1;
+	_count--;
 }
 
-- (NSString *)debugDescription {
-	return [NSString stringWithFormat:@"<%@: %p; %@, contents available: %d>",
-		self.class,
-		self,
-		NSStringFromMMMLoadableState(self.loadableState),
-		self.contentsAvailable
-	];
+/// Only the entries of the given slot are looked at, i.e. about 1/64th of all of them.
+- (void)updateMinTickForSlot:(NSInteger)slot {
+	int64_t result = INT64_MAX;
+	for (MMMAutosyncTimerEntry *entry in _slots[slot]) {
+		result = MIN(result, entry->_tick);
+	}
+	_slotMinTicks[slot] = result;
 }
 
-- (NSString *)description {
-	return [NSString stringWithFormat:@"<%@: %@, contents available: %d>",
-		self.class,
-		NSStringFromMMMLoadableState(self.loadableState),
-		self.contentsAvailable
-	];
+/// The earliest tick having an entry due.
+- (int64_t)nextTick {
+	int64_t result = INT64_MAX;
+	for (NSInteger i = 0; i < MMMAutosyncSchedulerSlotCount; i++) {
+		result = MIN(result, _slotMinTicks[i]);
+	}
+	return result;
 }
 
 @end
@@ -282,8 +1247,7 @@ NSString *NSStringFromMMMLoadableState(MMMLoadableState state) {
 //
 //
 @implementation MMMAutosyncLoadable	{
-	MMMWeakProxy *_autosyncTimerProxy;
-	NSTimer *_autosyncTimer;
+	MMMAutosyncTimerEntry *_autosyncTimerEntry;
 }
 
 - (id)init {
@@ -339,9 +1303,8 @@ NSString *NSStringFromMMMLoadableState(MMMLoadableState state) {
 }
 
 - (void)clearAutosyncTimer {
-	[_autosyncTimer invalidate];
-	_autosyncTimer = nil;
-	_autosyncTimerProxy = nil;
+	[[MMMAutosyncScheduler shared] cancel:_autosyncTimerEntry];
+	_autosyncTimerEntry = nil;
 }
 
 - (void)setupAutosyncTimer {
@@ -364,17 +1327,11 @@ NSString *NSStringFromMMMLoadableState(MMMLoadableState state) {
 	if (timeout <= 0)
 		return;
 
-	_autosyncTimerProxy = [[MMMWeakProxy alloc] initWithTarget:self];
-	_autosyncTimer = [NSTimer
-		scheduledTimerWithTimeInterval:timeout
-		target:_autosyncTimerProxy
-		selector:@selector(autosyncTimer)
-		userInfo:nil
-		repeats:NO
-	];
+	_autosyncTimerEntry = [[MMMAutosyncScheduler shared] scheduleTarget:self after:timeout];
 }
 
 - (void)autosyncTimer {
+	_autosyncTimerEntry = nil;
 	if (self.needsSync)
 		[self sync];
 	else
@@ -406,10 +1363,133 @@ NSString *NSStringFromMMMLoadableState(MMMLoadableState state) {
 
 #pragma mark - MMMLoadableObserver
 
+//
+// Common part of the proxies MMMLoadableObserver installs as actual observers.
+//
+@interface MMMLoadableObserverProxy : NSObject <MMMLoadableObserver>
+
+/// Makes the proxy ignore notifications that don't change `changeGeneration` of the given loadable
+/// (as compared to its value when this is called or during the previous notification). Nil to stop skipping.
+- (void)skipUnchangedOfLoadable:(id<MMMPureLoadable>)loadable;
+
+/// Makes the proxy forward only the notifications corresponding to the given events, comparing the state of the given
+/// loadable to the one it has now or had during the previous notification.
+- (void)filterEvents:(MMMLoadableObserverEvents)events ofLoadable:(id<MMMPureLoadable>)loadable;
+
+/// Makes the proxy forward notifications asynchronously on the given queue coalescing the ones that happen before
+/// the previous forwarding had a chance to run.
+- (void)forwardOnQueue:(dispatch_queue_t)queue;
+
+/// Stops forwarding anything: no forward is started after this returns, including the ones scheduled on the queue
+/// already. (A forward that has begun on another queue before that is not waited for.)
+- (void)cancel;
+
+/// Subclasses should override this instead of `loadableDidChange:` to actually forward the notification.
+- (void)forwardDidChange:(id<MMMPureLoadable>)loadable;
+
+@end
+
+@implementation MMMLoadableObserverProxy {
+
+	BOOL _skipsUnchanged;
+	uint64_t _lastGeneration;
+
+	BOOL _filtersEvents;
+	MMMLoadableObserverEvents _events;
+	MMMLoadableState _lastLoadableState;
+	BOOL _lastContentsAvailable;
+
+	dispatch_queue_t _queue;
+	// YES, when a forward is scheduled on the queue but has not begun yet.
+	atomic_bool _forwardPending;
+	// Set by `cancel`, which can be called on any queue; checked right before every forward on the target queue.
+	atomic_bool _cancelled;
+}
+
+- (void)skipUnchangedOfLoadable:(id<MMMPureLoadable>)loadable {
+	_skipsUnchanged = [loadable respondsToSelector:@selector(changeGeneration)];
+	_lastGeneration = _skipsUnchanged ? loadable.changeGeneration : 0;
+}
+
+- (void)filterEvents:(MMMLoadableObserverEvents)events ofLoadable:(id<MMMPureLoadable>)loadable {
+	_filtersEvents = (events & MMMLoadableObserverEventAll) != MMMLoadableObserverEventAll;
+	_events = events;
+	_lastLoadableState = loadable.loadableState;
+	_lastContentsAvailable = loadable.contentsAvailable;
+}
+
+- (BOOL)hasEventOfInterestIn:(id<MMMPureLoadable>)loadable {
+
+	MMMLoadableState loadableState = loadable.loadableState;
+	BOOL contentsAvailable = loadable.contentsAvailable;
+
+	MMMLoadableObserverEvents events = 0;
+	if (loadableState != _lastLoadableState)
+		events |= (MMMLoadableObserverEvents)1 << loadableState;
+	if (contentsAvailable != _lastContentsAvailable) {
+		events |= contentsAvailable
+			? MMMLoadableObserverEventContentsBecameAvailable
+			: MMMLoadableObserverEventContentsBecameUnavailable;
+	}
+	if (events == 0)
+		events = MMMLoadableObserverEventContentsDidChange;
+
+	_lastLoadableState = loadableState;
+	_lastContentsAvailable = contentsAvailable;
+
+	return (events & _events) != 0;
+}
+
+- (void)loadableDidChange:(id<MMMPureLoadable>)loadable {
+
+	if (_skipsUnchanged) {
+		uint64_t generation = loadable.changeGeneration;
+		if (generation == _lastGeneration)
+			return;
+		_lastGeneration = generation;
+	}
+
+	// Filtering here and not in the loadable: events are relative to what this particular observer has seen before
+	// and any implementation of MMMPureLoadable can be observed. This is still before anything is scheduled or called.
+	if (_filtersEvents && ![self hasEventOfInterestIn:loadable])
+		return;
+
+	if (!_queue) {
+		[self forwardDidChange:loadable];
+		return;
+	}
+
+	if (atomic_exchange(&_forwardPending, true)) {
+		// Already scheduled, the forward will pick the latest state anyway.
+		return;
+	}
+
+	dispatch_async(_queue, ^{
+		// Clearing first, so the changes happening while forwarding schedule another call.
+		atomic_store(&self->_forwardPending, false);
+		if (!atomic_load_explicit(&self->_cancelled, memory_order_acquire))
+			[self forwardDidChange:loadable];
+	});
+}
+
+- (void)forwardOnQueue:(dispatch_queue_t)queue {
+	_queue = queue;
+}
+
+- (void)cancel {
+	atomic_store_explicit(&_cancelled, true, memory_order_release);
+}
+
+- (void)forwardDidChange:(id<MMMPureLoadable>)loadable {
+	MMM_MUST_BE_IMPLEMENTED();
+}
+
+@end
+
 //
 //
 //
-@interface MMMLoadableObserverBlockProxy : NSObject <MMMLoadableObserver>
+@interface MMMLoadableObserverBlockProxy : MMMLoadableObserverProxy
 @end
 
 @implementation MMMLoadableObserverBlockProxy {
@@ -427,7 +1507,7 @@ NSString *NSStringFromMMMLoadableState(MMMLoadableState state) {
 	return self;
 }
 
-- (void)loadableDidChange:(id<MMMLoadable>)loadable {
+- (void)forwardDidChange:(id<MMMPureLoadable>)loadable {
 	_block(loadable);
 }
 
@@ -436,12 +1516,14 @@ NSString *NSStringFromMMMLoadableState(MMMLoadableState state) {
 //
 //
 //
-@interface MMMLoadableObserverSelectorProxy : NSObject <MMMLoadableObserver>
+@interface MMMLoadableObserverSelectorProxy : MMMLoadableObserverProxy
 @end
 
 @implementation MMMLoadableObserverSelectorProxy {
 	id<NSObject> __weak _target;
 	SEL _selector;
+	// Resolved once here instead of going through `performSelector:` on every notification.
+	void (*_imp)(id, SEL, id);
 }
 
 - (NSString *)description {
@@ -453,12 +1535,14 @@ NSString *NSStringFromMMMLoadableState(MMMLoadableState state) {
 	if (self = [super init]) {
 		_target = target;
 		_selector = selector;
+		NSAssert([target respondsToSelector:selector], @"%@ does not respond to %@", target, NSStringFromSelector(selector));
+		_imp = (void (*)(id, SEL, id))[(NSObject *)target methodForSelector:selector];
 	}
 
 	return self;
 }
 
-- (void)loadableDidChange:(id<MMMLoadable>)loadable {
+- (void)forwardDidChange:(id<MMMPureLoadable>)loadable {
 
 	id target = _target;
 	if (!target) {
@@ -466,10 +1550,7 @@ NSString *NSStringFromMMMLoadableState(MMMLoadableState state) {
 		return;
 	}
 
-	#pragma clang diagnostic push
-	#pragma clang diagnostic ignored "-Warc-performSelector-leaks"
-	[target performSelector:_selector withObject:loadable];
-	#pragma clang diagnostic pop
+	_imp(target, _selector, loadable);
 }
 
 @end
@@ -523,6 +1604,55 @@ NSString *NSStringFromMMMLoadableState(MMMLoadableState state) {
 	return nil;
 }
 
+- (nullable id)initWithLoadable:(nullable id<MMMPureLoadable>)loadable
+	events:(MMMLoadableObserverEvents)events
+	block:(MMMLoadableObserverDidChangeBlock)block
+{
+	if (loadable) {
+		MMMLoadableObserverProxy *proxy = [[MMMLoadableObserverBlockProxy alloc] initWithBlock:block];
+		[proxy filterEvents:events ofLoadable:loadable];
+		return [self initWithLoadable:loadable proxy:proxy];
+	}
+
+	return nil;
+}
+
+- (nullable id)initWithLoadable:(nullable id<MMMPureLoadable>)loadable
+	events:(MMMLoadableObserverEvents)events
+	target:(id<NSObject>)target
+	selector:(SEL)selector
+{
+	if (loadable) {
+		MMMLoadableObserverProxy *proxy = [[MMMLoadableObserverSelectorProxy alloc] initWithTarget:target selector:selector];
+		[proxy filterEvents:events ofLoadable:loadable];
+		return [self initWithLoadable:loadable proxy:proxy];
+	}
+
+	return nil;
+}
+
+- (nullable id)initWithLoadable:(nullable id<MMMPureLoadable>)loadable
+	queue:(dispatch_queue_t)queue
+	block:(MMMLoadableObserverDidChangeBlock)block
+{
+	return [self initWithLoadable:loadable events:MMMLoadableObserverEventAll queue:queue block:block];
+}
+
+- (nullable id)initWithLoadable:(nullable id<MMMPureLoadable>)loadable
+	events:(MMMLoadableObserverEvents)events
+	queue:(dispatch_queue_t)queue
+	block:(MMMLoadableObserverDidChangeBlock)block
+{
+	if (loadable) {
+		MMMLoadableObserverProxy *proxy = [[MMMLoadableObserverBlockProxy alloc] initWithBlock:block];
+		[proxy filterEvents:events ofLoadable:loadable];
+		[proxy forwardOnQueue:queue];
+		return [self initWithLoadable:loadable proxy:proxy];
+	}
+
+	return nil;
+}
+
 - (id)initWithLoadable:(id<MMMLoadable>)loadable observer:(id<MMMLoadableObserver>)observer {
 	return [self initWithLoadable:loadable proxy:observer];
 }
@@ -537,6 +1667,69 @@ NSString *NSStringFromMMMLoadableState(MMMLoadableState state) {
 		[_loadable removeObserver:_proxy];
 		_loadable = nil;
 	}
+	// In case anything has been scheduled on the queue already.
+	if ([_proxy isKindOfClass:[MMMLoadableObserverProxy class]])
+		[(MMMLoadableObserverProxy *)_proxy cancel];
+}
+
+- (void)setSkipsUnchanged:(BOOL)skipsUnchanged {
+
+	_skipsUnchanged = skipsUnchanged;
+
+	if ([_proxy isKindOfClass:[MMMLoadableObserverProxy class]]) {
+		[(MMMLoadableObserverProxy *)_proxy skipUnchangedOfLoadable:skipsUnchanged ? _loadable : nil];
+	} else {
+		NSAssert(!skipsUnchanged, @"Skipping is supported only with our own proxies");
+	}
+}
+
+@end
+
+//
+// What a group remembers about each of its (distinct) children, so a change in one of them can be accounted for
+// without looking at the rest.
+//
+@interface MMMPureLoadableGroupChild : NSObject
+
+@property (nonatomic, readonly) id<MMMPureLoadable> loadable;
+
+/// How many times this child appears in the `loadables` array of the group.
+/// (The group observes every distinct child once regardless.)
+@property (nonatomic, readwrite) NSInteger count;
+
+/// YES, if the child supports `sync` (figured out once, because it cannot change).
+@property (nonatomic, readonly) BOOL syncable;
+
+/// The state of the child as of the last time the group has looked at it.
+@property (nonatomic, readonly) MMMLoadableState loadableState;
+@property (nonatomic, readonly) BOOL contentsAvailable;
+
+- (id)initWithLoadable:(id<MMMPureLoadable>)loadable NS_DESIGNATED_INITIALIZER;
+- (id)init NS_UNAVAILABLE;
+
+/// Refreshes `loadableState` and `contentsAvailable` from the child itself.
+- (void)update;
+
+@end
+
+@implementation MMMPureLoadableGroupChild
+
+- (id)initWithLoadable:(id<MMMPureLoadable>)loadable {
+	if (self = [super init]) {
+		_loadable = loadable;
+		_syncable = [loadable conformsToProtocol:@protocol(MMMLoadable)];
+		[self update];
+	}
+	return self;
+}
+
+- (void)update {
+	_loadableState = _loadable.loadableState;
+	_contentsAvailable = [_loadable isContentsAvailable];
+	NSAssert(
+		MMMLoadableStateIdle <= _loadableState && _loadableState <= MMMLoadableStateDidFailToSync,
+		@"Unexpected state of %@", _loadable
+	);
 }
 
 @end
@@ -544,19 +1737,55 @@ NSString *NSStringFromMMMLoadableState(MMMLoadableState state) {
 //
 //
 //
-@interface MMMPureLoadableGroup ()
+@interface MMMPureLoadableGroup () <MMMLoadableBatchable>
 @property (nonatomic, readwrite) NSArray<id<MMMPureLoadable>> *loadables;
+/// YES, if the given object is one of the children of the group.
+- (BOOL)MMMPureLoadableGroup_containsLoadable:(id<MMMPureLoadable>)loadable;
+/// Called from `setLoadables:` after the children are updated, but before the new ones are subscribed to
+/// and the state of the group is updated.
+- (void)MMMPureLoadableGroup_loadablesDidChange;
+/// The children supporting `sync` in the order of `loadables` (duplicates included), based on what has been figured out
+/// about every child when it was added. The same array as `loadables` when all of them support it.
+- (NSArray<id<MMMLoadable>> *)MMMPureLoadableGroup_syncableLoadables;
+/// Distinct children that have failed to sync and support syncing, in the order they've failed.
+- (NSArray<id<MMMLoadable>> *)MMMPureLoadableGroup_failedSyncableLoadables;
+/// Called for every "did change" of a child after the counters are updated, but before the state of the group is.
+- (void)MMMPureLoadableGroup_childDidChange:(id<MMMPureLoadable>)loadable;
+/// YES, if the group uses "race" or "quorum" failure policy and enough children have synced successfully already.
+- (BOOL)MMMPureLoadableGroup_hasEnoughSuccesses;
 @end
 
 @implementation MMMPureLoadableGroup {
-	MMMObserverHub<id<MMMLoadableObserver>> *_observerHub;
+
+	MMMLoadableObserverList _observers;
 	MMMLoadableObserverSelectorProxy *_observerProxy;
 	MMMLoadableGroupFailurePolicy _failurePolicy;
+
+	// Children of the group by identity. We don't need weak references here as `_loadables` retains them anyway.
+	NSMapTable<id<MMMPureLoadable>, MMMPureLoadableGroupChild *> *_children;
+
+	// The number of entries in `_loadables` not supporting `sync` (duplicates counted separately).
+	NSInteger _unsyncableCount;
+
+	// The number of children in each of the states (indexed by MMMLoadableState, duplicates counted separately),
+	// so the state of the whole group can be figured out without scanning all the children on every change.
+	NSInteger _stateCounts[MMMLoadableStateDidFailToSync + 1];
+
+	// The number of children (again, duplicates counted separately) that don't have their contents available.
+	NSInteger _contentsUnavailableCount;
+
+	// Distinct children that have failed to sync, in the order they've failed.
+	NSMutableOrderedSet<MMMPureLoadableGroupChild *> *_failedChildren;
+	// The error based on the first of the failed children, built when asked for and reset when the failed ones change.
+	NSError *_error;
+
+	uint64_t _changeGeneration;
 }
 
 @synthesize loadables = _loadables;
 @synthesize contentsAvailable = _contentsAvailable;
 @synthesize loadableState = _loadableState;
+@synthesize quorum = _quorum;
 
 - (id)initWithLoadables:(NSArray *)loadables failurePolicy:(MMMLoadableGroupFailurePolicy)failurePolicy {
 
@@ -570,103 +1799,313 @@ NSString *NSStringFromMMMLoadableState(MMMLoadableState state) {
 			selector:@selector(MMMPureLoadableGroup_loadableDidChange:)
 		];
 
-		_observerHub = [[MMMObserverHub alloc] initWithObservable:self];
+		_children = [[NSMapTable alloc]
+			initWithKeyOptions:NSPointerFunctionsStrongMemory | NSPointerFunctionsObjectPointerPersonality
+			valueOptions:NSPointerFunctionsStrongMemory
+			capacity:loadables.count
+		];
         
 		[self setLoadables:loadables];
 	}
 
-	return self;
+	return self;
+}
+
+- (id)initWithLoadables:(nullable NSArray<id<MMMPureLoadable>> *)loadables {
+	return [self initWithLoadables:loadables failurePolicy:MMMLoadableGroupFailurePolicyStrict];
+}
+
+- (id)initWithLoadables:(nullable NSArray<id<MMMPureLoadable>> *)loadables quorum:(NSInteger)quorum {
+	if (self = [self initWithLoadables:nil failurePolicy:MMMLoadableGroupFailurePolicyQuorum]) {
+		// Setting the children after the quorum, so the state is calculated once.
+		_quorum = quorum;
+		[self setLoadables:loadables];
+	}
+	return self;
+}
+
+- (void)dealloc {
+	// It is tempting to call setLoadables:nil, but this can trigger 'did change' when we don't really want it.
+	// (We are subscribed once per distinct child.)
+	for (id<MMMPureLoadable> loadable in _children) {
+		[loadable removeObserver:_observerProxy];
+	}
+	_loadables = nil;
+
+	MMMLoadableObserverListFree(&_observers);
+}
+
+- (void)setLoadables:(NSArray *)loadables {
+
+	NSArray<id<MMMPureLoadable>> *oldLoadables = _loadables;
+	NSUInteger oldCount = oldLoadables.count;
+	NSUInteger newCount = loadables.count;
+
+	// Paginated lists typically append to (or trim) the group, so the common prefix and suffix are skipped quickly
+	// and only the rest is looked at.
+	NSUInteger prefix = 0;
+	while (prefix < oldCount && prefix < newCount && oldLoadables[prefix] == loadables[prefix])
+		prefix++;
+	NSUInteger suffix = 0;
+	while (prefix + suffix < oldCount && prefix + suffix < newCount
+		&& oldLoadables[oldCount - 1 - suffix] == loadables[newCount - 1 - suffix]
+	) {
+		suffix++;
+	}
+
+	// The caller might pass a mutable array and change it later. (Free for immutable arrays.)
+	_loadables = [loadables copy];
+
+	// Adding before removing, so the children that have just moved within the array are not resubscribed.
+	// Note that snapshots of new children are taken before subscribing, because adding an observer can cause
+	// a child to change (and notify us) right away.
+	NSMutableArray<id<MMMPureLoadable>> *toSubscribe = [[NSMutableArray alloc] init];
+	for (NSUInteger i = prefix; i < newCount - suffix; i++) {
+		id<MMMPureLoadable> loadable = loadables[i];
+		MMMPureLoadableGroupChild *child = [_children objectForKey:loadable];
+		if (!child) {
+			NSAssert(
+				[loadable conformsToProtocol:@protocol(MMMPureLoadable)],
+				@"All objects in %@ must conform at least to %@", self.class, @protocol(MMMPureLoadable)
+			);
+			child = [[MMMPureLoadableGroupChild alloc] initWithLoadable:loadable];
+			[_children setObject:child forKey:loadable];
+			[toSubscribe addObject:loadable];
+			[self trackFailureOfChild:child wasFailed:NO];
+		}
+		child.count++;
+		if (!child.syncable)
+			_unsyncableCount++;
+		[self accountForChild:child times:1];
+	}
+
+	for (NSUInteger i = prefix; i < oldCount - suffix; i++) {
+		id<MMMPureLoadable> loadable = oldLoadables[i];
+		MMMPureLoadableGroupChild *child = [_children objectForKey:loadable];
+		NSAssert(child != nil, @"");
+		[self accountForChild:child times:-1];
+		child.count--;
+		if (!child.syncable)
+			_unsyncableCount--;
+		if (child.count == 0) {
+			if (child.loadableState == MMMLoadableStateDidFailToSync) {
+				[_failedChildren removeObject:child];
+				_error = nil;
+			}
+			[_children removeObjectForKey:loadable];
+			[loadable removeObserver:_observerProxy];
+		}
+	}
+
+	// Before subscribing, because a new child can notify us right away and observers of the group might want
+	// to sync it as soon as it changes.
+	[self MMMPureLoadableGroup_loadablesDidChange];
+
+	for (id<MMMPureLoadable> loadable in toSubscribe) {
+		[loadable addObserver:_observerProxy];
+	}
+
+	[self updateState];
 }
 
-- (id)initWithLoadables:(nullable NSArray<id<MMMPureLoadable>> *)loadables {
-	return [self initWithLoadables:loadables failurePolicy:MMMLoadableGroupFailurePolicyStrict];
+- (void)MMMPureLoadableGroup_loadablesDidChange {
+	// Nothing to do here, but MMMLoadableGroup needs it.
 }
 
-- (void)dealloc {
-	// It is tempting to call setLoadables:nil, but this can trigger 'did change' when we don't really want it.
-	for (id<MMMLoadable> loadable in _loadables) {
-		[loadable removeObserver:_observerProxy];
+- (NSArray<id<MMMLoadable>> *)MMMPureLoadableGroup_syncableLoadables {
+
+	if (_unsyncableCount == 0)
+		return (NSArray<id<MMMLoadable>> *)_loadables;
+
+	NSMutableArray<id<MMMLoadable>> *result = [[NSMutableArray alloc]
+		initWithCapacity:_loadables.count - (NSUInteger)_unsyncableCount
+	];
+	for (id<MMMPureLoadable> loadable in _loadables) {
+		if ([_children objectForKey:loadable].syncable)
+			[result addObject:(id<MMMLoadable>)loadable];
 	}
-	_loadables = nil;
+	return result;
 }
 
-- (void)setLoadables:(NSArray *)loadables {
+/// Adds the last known state of the given child to the counters of the group the given number of times
+/// (negative to remove it).
+- (void)accountForChild:(MMMPureLoadableGroupChild *)child times:(NSInteger)times {
+	// Asserted in the child already, but a bogus state should not corrupt the memory in release builds either.
+	// (Such a child is simply not accounted for, same on the way in and out, as the snapshot is the same.)
+	MMMLoadableState state = child.loadableState;
+	if (state < MMMLoadableStateIdle || state > MMMLoadableStateDidFailToSync)
+		return;
+	_stateCounts[state] += times;
+	if (!child.contentsAvailable)
+		_contentsUnavailableCount += times;
+}
 
-	for (id<MMMLoadable> loadable in _loadables) {
-		[loadable removeObserver:_observerProxy];
-	}
+/// Updates the list of failed children after the state of the given one has been (re)read.
+- (void)trackFailureOfChild:(MMMPureLoadableGroupChild *)child wasFailed:(BOOL)wasFailed {
 
-	_loadables = loadables;
-	for (id<MMMLoadable> loadable in _loadables) {
-		[loadable addObserver:_observerProxy];
+	BOOL failed = child.loadableState == MMMLoadableStateDidFailToSync;
+	if (!failed && !wasFailed)
+		return;
+
+	if (!_failedChildren)
+		_failedChildren = [[NSMutableOrderedSet alloc] init];
+
+	if (failed && !wasFailed) {
+		[_failedChildren addObject:child];
+	} else if (!failed && wasFailed) {
+		[_failedChildren removeObject:child];
+	} else {
+		// Failed again, the error could be different now.
 	}
 
-	[self updateState];
+	_error = nil;
 }
 
 - (NSError *)error {
 
+	if (_error)
+		return _error;
+
 	// OK, let's use the error of the first failed object.
-	for (id<MMMLoadable> l in _loadables) {
-		if (l.loadableState == MMMLoadableStateDidFailToSync && l.error != nil) {
-			return [NSError
+	for (MMMPureLoadableGroupChild *child in _failedChildren) {
+		id<MMMPureLoadable> l = child.loadable;
+		if (l.error != nil) {
+			_error = [NSError
 				mmm_errorWithDomain:NSStringFromClass(self.class)
 				message:[NSString stringWithFormat:@"Could not sync %@", l]
 				underlyingError:l.error
 			];
+			return _error;
 		}
 	}
 
 	return nil;
 }
 
+- (NSArray<id<MMMLoadable>> *)MMMPureLoadableGroup_failedSyncableLoadables {
+
+	NSMutableArray<id<MMMLoadable>> *result = [[NSMutableArray alloc] initWithCapacity:_failedChildren.count];
+	for (MMMPureLoadableGroupChild *child in _failedChildren) {
+		if (child.syncable)
+			[result addObject:(id<MMMLoadable>)child.loadable];
+	}
+
+	return result;
+}
+
+- (NSArray<id<MMMPureLoadable>> *)failedLoadables {
+
+	NSMutableArray<id<MMMPureLoadable>> *result = [[NSMutableArray alloc] initWithCapacity:_failedChildren.count];
+	for (MMMPureLoadableGroupChild *child in _failedChildren) {
+		[result addObject:child.loadable];
+	}
+
+	return result;
+}
+
+- (void)setQuorum:(NSInteger)quorum {
+	if (_quorum != quorum) {
+		_quorum = quorum;
+		[self updateState];
+	}
+}
+
+- (BOOL)MMMPureLoadableGroup_hasEnoughSuccesses {
+	return (_failurePolicy == MMMLoadableGroupFailurePolicyRace || _failurePolicy == MMMLoadableGroupFailurePolicyQuorum)
+		&& _loadables.count > 0
+		&& _stateCounts[MMMLoadableStateDidSyncSuccessfully] >= [self requiredSuccessCount];
+}
+
+/// How many children have to succeed under "race" or "quorum" policies for the whole group to succeed.
+- (NSInteger)requiredSuccessCount {
+	if (_failurePolicy == MMMLoadableGroupFailurePolicyRace)
+		return 1;
+	NSInteger count = _loadables.count;
+	return (_quorum < 1 || _quorum > count) ? count : _quorum;
+}
+
+- (id<MMMPureLoadable>)raceWinner {
+
+	if (_stateCounts[MMMLoadableStateDidSyncSuccessfully] == 0)
+		return nil;
+
+	for (id<MMMPureLoadable> loadable in _loadables) {
+		if (loadable.loadableState == MMMLoadableStateDidSyncSuccessfully)
+			return loadable;
+	}
+
+	return nil;
+}
+
 - (void)MMMPureLoadableGroup_loadableDidChange:(id<MMMPureLoadable>)loadable {
+
+	MMMPureLoadableGroupChild *child = [_children objectForKey:loadable];
+	if (child) {
+		[self accountForChild:child times:-child.count];
+		BOOL wasFailed = child.loadableState == MMMLoadableStateDidFailToSync;
+		[child update];
+		[self accountForChild:child times:child.count];
+		[self trackFailureOfChild:child wasFailed:wasFailed];
+	} else {
+		// Can be a late notification from a child that was removed while its observers were being notified.
+	}
+
+	[self MMMPureLoadableGroup_childDidChange:loadable];
+
 	[self updateState];
 }
 
+- (void)MMMPureLoadableGroup_childDidChange:(id<MMMPureLoadable>)loadable {
+	// Nothing to do here, but MMMLoadableGroup needs it.
+}
+
+- (BOOL)MMMPureLoadableGroup_containsLoadable:(id<MMMPureLoadable>)loadable {
+	return [_children objectForKey:loadable] != nil;
+}
+
 - (void)updateState {
 
+	NSInteger count = _loadables.count;
 	NSInteger failedCount = 0;
 	NSInteger syncedCount = 0;
-	NSInteger syncingCount = 0;
-	for (id<MMMLoadable> loadable in _loadables) {
-        switch (_failurePolicy) {
-            case MMMLoadableGroupFailurePolicyStrict:
-                if (loadable.loadableState == MMMLoadableStateDidFailToSync) {
-                    failedCount++;
-                } else if (loadable.loadableState == MMMLoadableStateDidSyncSuccessfully) {
-                    syncedCount++;
-                } else if (loadable.loadableState == MMMLoadableStateSyncing) {
-                    syncingCount++;
-                }
-                break;
-                
-            case MMMLoadableGroupFailurePolicyNever:
-                if (loadable.loadableState == MMMLoadableStateDidFailToSync 
-					|| loadable.loadableState == MMMLoadableStateDidSyncSuccessfully
-				) {
-                    syncedCount++;
-                } else if (loadable.loadableState == MMMLoadableStateSyncing) {
-                    syncingCount++;
-                }
-                break;
-        }
+	NSInteger syncingCount = _stateCounts[MMMLoadableStateSyncing];
+	switch (_failurePolicy) {
+		case MMMLoadableGroupFailurePolicyStrict:
+			failedCount = _stateCounts[MMMLoadableStateDidFailToSync];
+			syncedCount = _stateCounts[MMMLoadableStateDidSyncSuccessfully];
+			break;
+		case MMMLoadableGroupFailurePolicyNever:
+			syncedCount = _stateCounts[MMMLoadableStateDidFailToSync] + _stateCounts[MMMLoadableStateDidSyncSuccessfully];
+			break;
+		case MMMLoadableGroupFailurePolicyRace:
+		case MMMLoadableGroupFailurePolicyQuorum:
+			// Enough successes win over the children that are still syncing or have failed;
+			// and enough failures make the group fail even if some of the children are still syncing.
+			if (count > 0) {
+				NSInteger required = [self requiredSuccessCount];
+				if (_stateCounts[MMMLoadableStateDidSyncSuccessfully] >= required) {
+					syncedCount = count;
+					syncingCount = 0;
+				} else if (_stateCounts[MMMLoadableStateDidFailToSync] > count - required) {
+					failedCount = _stateCounts[MMMLoadableStateDidFailToSync];
+				}
+			}
+			break;
 	}
 
+	// Assuming no content in case the group is empty.
+	// This way initializing the group with an empty array (something we do for convenience before setting the actual array)
+	// won't lead to a useless 'did change' notification.
 	BOOL newContentsAvailable;
-	if (_loadables.count == 0) {
-		// Assuming no content in case the group is empty.
-		// This way initializing the group with an empty array (something we do for convenience before setting the actual array)
-		// won't lead to a useless 'did change' notification.
-		newContentsAvailable = NO;
-	} else {
-	 	newContentsAvailable = YES;
-		for (id<MMMLoadable> loadable in _loadables) {
-			if (![loadable isContentsAvailable]) {
-				newContentsAvailable = NO;
-				break;
-			}
-		}
+	switch (_failurePolicy) {
+		case MMMLoadableGroupFailurePolicyStrict:
+		case MMMLoadableGroupFailurePolicyNever:
+			newContentsAvailable = count > 0 && _contentsUnavailableCount == 0;
+			break;
+		case MMMLoadableGroupFailurePolicyRace:
+		case MMMLoadableGroupFailurePolicyQuorum:
+			newContentsAvailable = count > 0 && count - _contentsUnavailableCount >= [self requiredSuccessCount];
+			break;
 	}
 
 	MMMLoadableState newLoadableState;
@@ -674,7 +2113,7 @@ NSString *NSStringFromMMMLoadableState(MMMLoadableState state) {
 		newLoadableState = MMMLoadableStateDidFailToSync;
 	} else if (syncingCount > 0) {
 		newLoadableState = MMMLoadableStateSyncing;
-	} else if (syncedCount > 0 && syncedCount == _loadables.count) {
+	} else if (syncedCount > 0 && syncedCount == count) {
 		newLoadableState = MMMLoadableStateDidSyncSuccessfully;
 	} else {
 		// Again, avoiding 'did sync' for empty groups, preferring 'idle'.
@@ -700,21 +2139,36 @@ NSString *NSStringFromMMMLoadableState(MMMLoadableState state) {
 }
 
 - (void)addObserver:(id<MMMLoadableObserver>)observer {
-	[_observerHub addObserver:observer];
+	MMMLoadableObserverListAdd(&_observers, observer);
 }
 
 - (void)removeObserver:(id<MMMLoadableObserver>)observer {
-	[_observerHub removeObserver:observer];
+	MMMLoadableObserverListRemove(&_observers, observer);
 }
 
 - (void)groupDidChange {
 	// This can be overriden in the subclasses of the group.
 }
 
+- (uint64_t)changeGeneration {
+	return _changeGeneration;
+}
+
+- (void)performBatchUpdates:(NS_NOESCAPE void (^)(void))updates {
+	MMMLoadablePerformBatchUpdates(updates);
+}
+
 - (void)notifyDidChange {
-	[_observerHub forEachObserver:^(id<MMMLoadableObserver> observer) {
-		[observer loadableDidChange:self];
-	}];
+
+	_changeGeneration++;
+
+	if (MMMLoadableBatchDefer(self))
+		return;
+	[self MMMLoadable_notifyObservers];
+}
+
+- (void)MMMLoadable_notifyObservers {
+	MMMLoadableObserverListNotify(&_observers, self);
 }
 
 - (NSString *)description {
@@ -730,7 +2184,22 @@ NSString *NSStringFromMMMLoadableState(MMMLoadableState state) {
 //
 //
 //
-@implementation MMMLoadableGroup
+@implementation MMMLoadableGroup {
+	// Children waiting for their turn to sync when `maxConcurrentSyncs` is limited.
+	NSMutableArray<id<MMMLoadable>> *_syncQueue;
+	// The index of the next child in `_syncQueue` to start, so taking one off the queue does not shift the rest.
+	NSUInteger _syncQueueHead;
+	// YES, if the children in the queue should be asked to `sync` rather than `syncIfNeeded`.
+	BOOL _syncQueueForced;
+	// Children started from the queue and not done syncing yet.
+	NSHashTable<id<MMMLoadable>> *_syncsInFlight;
+	BOOL _startingQueuedSyncs;
+	// The children supporting `sync` in the order of `loadables` (duplicates included), updated in `setLoadables:`
+	// from what the group knows about every child, so the sync paths don't have to ask them about their protocols.
+	NSArray<id<MMMLoadable>> *_syncableLoadables;
+	// YES, when the losers of a race are going to be cancelled, see `MMMPureLoadableGroup_childDidChange:`.
+	BOOL _cancelLosersScheduled;
+}
 
 - (id)initWithLoadables:(NSArray<id<MMMLoadable>> *)loadables failurePolicy:(MMMLoadableGroupFailurePolicy)failurePolicy {
 	return [super initWithLoadables:loadables failurePolicy:failurePolicy];
@@ -740,22 +2209,37 @@ NSString *NSStringFromMMMLoadableState(MMMLoadableState state) {
 	return [self initWithLoadables:loadables failurePolicy:MMMLoadableGroupFailurePolicyStrict];
 }
 
+- (id)initWithLoadables:(nullable NSArray<id<MMMPureLoadable>> *)loadables quorum:(NSInteger)quorum {
+	if (self = [self initWithLoadables:nil failurePolicy:MMMLoadableGroupFailurePolicyQuorum]) {
+		// Setting the children after the quorum, so the state is calculated once.
+		self.quorum = quorum;
+		self.loadables = loadables;
+	}
+	return self;
+}
+
 - (void)setLoadables:(NSArray<id<MMMLoadable>> *)loadables {
 
 	[super setLoadables:loadables];
 
-	for (id<MMMLoadable> loadable in self.loadables) {
-		NSAssert(
-			[loadable conformsToProtocol:@protocol(MMMPureLoadable)],
-			@"All objects in %@ must conform at least to %@", self.class, @protocol(MMMLoadable)
-		);
+	// We won't hear from the removed children anymore, so they should not occupy their sync slots.
+	if (_syncsInFlight.count > 0) {
+		for (id<MMMLoadable> loadable in [_syncsInFlight allObjects]) {
+			if (![self MMMPureLoadableGroup_containsLoadable:loadable])
+				[_syncsInFlight removeObject:loadable];
+		}
+		[self startQueuedSyncs];
 	}
 }
 
+- (void)MMMPureLoadableGroup_loadablesDidChange {
+	_syncableLoadables = [self MMMPureLoadableGroup_syncableLoadables];
+}
+
 - (BOOL)needsSync {
 
-	for (id<MMMLoadable> loadable in self.loadables) {
-		if ([loadable conformsToProtocol:@protocol(MMMLoadable)] && [loadable needsSync]) {
+	for (id<MMMLoadable> loadable in _syncableLoadables) {
+		if ([loadable needsSync]) {
 			return YES;
 		}
 	}
@@ -764,19 +2248,175 @@ NSString *NSStringFromMMMLoadableState(MMMLoadableState state) {
 }
 
 - (void)sync {
-	for (id<MMMLoadable> loadable in self.loadables) {
-		if ([loadable conformsToProtocol:@protocol(MMMLoadable)]) {
-			[loadable sync];
-		}
+
+	if (_maxConcurrentSyncs > 0) {
+		[self enqueueSyncs:_syncableLoadables forced:YES];
+		return;
+	}
+
+	for (id<MMMLoadable> loadable in _syncableLoadables) {
+		[loadable sync];
 	}
 }
 
 - (void)syncIfNeeded {
-	for (id<MMMLoadable> loadable in self.loadables) {
-		if ([loadable conformsToProtocol:@protocol(MMMLoadable)]) {
-			[loadable syncIfNeeded];
+
+	if (_maxConcurrentSyncs > 0) {
+		[self enqueueSyncs:_syncableLoadables forced:NO];
+		return;
+	}
+
+	for (id<MMMLoadable> loadable in _syncableLoadables) {
+		[loadable syncIfNeeded];
+	}
+}
+
+- (void)syncFailed {
+
+	// A snapshot, as the children can change (and leave the failed set) while being asked to sync.
+	NSArray<id<MMMLoadable>> *failed = [self MMMPureLoadableGroup_failedSyncableLoadables];
+	if (failed.count == 0)
+		return;
+
+	if (_maxConcurrentSyncs > 0) {
+		[self enqueueSyncs:failed forced:YES];
+		return;
+	}
+
+	for (id<MMMLoadable> loadable in failed) {
+		[loadable sync];
+	}
+}
+
+- (void)cancelSync {
+
+	// Whatever was waiting for its turn is not needed either.
+	_syncQueue = nil;
+	_syncQueueHead = 0;
+	[_syncsInFlight removeAllObjects];
+
+	[self cancelSyncingLoadables];
+}
+
+- (void)cancelLosers {
+	_cancelLosersScheduled = NO;
+	// Unless the winners have changed their minds meanwhile.
+	if ([self MMMPureLoadableGroup_hasEnoughSuccesses])
+		[self cancelSync];
+}
+
+- (void)cancelSyncingLoadables {
+	for (id<MMMLoadable> loadable in _syncableLoadables) {
+		if (loadable.loadableState == MMMLoadableStateSyncing && [loadable respondsToSelector:@selector(cancelSync)])
+			[loadable cancelSync];
+	}
+}
+
+#pragma mark - Bounded concurrency
+
+- (void)enqueueSyncs:(NSArray<id<MMMLoadable>> *)loadables forced:(BOOL)forced {
+
+	if (!_syncsInFlight) {
+		_syncsInFlight = [[NSHashTable alloc]
+			initWithOptions:NSPointerFunctionsStrongMemory | NSPointerFunctionsObjectPointerPersonality
+			capacity:_maxConcurrentSyncs
+		];
+	}
+
+	// `sync` wins over `syncIfNeeded` still waiting for its turn.
+	_syncQueueForced = forced || (_syncQueueHead < _syncQueue.count && _syncQueueForced);
+
+	// Appending to whatever is waiting already, so a new request (e.g. `syncFailed` for a few children)
+	// does not drop the children that have been queued before. The ones already started are dropped now.
+	if (!_syncQueue) {
+		_syncQueue = [[NSMutableArray alloc] initWithCapacity:loadables.count];
+	} else if (_syncQueueHead > 0) {
+		[_syncQueue removeObjectsInRange:NSMakeRange(0, _syncQueueHead)];
+		_syncQueueHead = 0;
+	}
+
+	// Skipping the children that are queued or syncing already, as well as duplicates within the request.
+	NSHashTable<id<MMMLoadable>> *queued = [[NSHashTable alloc]
+		initWithOptions:NSPointerFunctionsWeakMemory | NSPointerFunctionsObjectPointerPersonality
+		capacity:_syncQueue.count + loadables.count
+	];
+	for (id<MMMLoadable> loadable in _syncQueue) {
+		[queued addObject:loadable];
+	}
+	NSUInteger oldCount = _syncQueue.count;
+	for (id<MMMLoadable> loadable in loadables) {
+		if (![_syncsInFlight containsObject:loadable] && ![queued containsObject:loadable]) {
+			[queued addObject:loadable];
+			[_syncQueue addObject:loadable];
 		}
 	}
+
+	if (_syncOrder && _syncQueue.count > oldCount) {
+		[_syncQueue sortWithOptions:NSSortStable usingComparator:(NSComparator)_syncOrder];
+	}
+
+	[self startQueuedSyncs];
+}
+
+- (void)startQueuedSyncs {
+
+	// The loop below will pick up the slots freed by the children finishing synchronously.
+	if (_startingQueuedSyncs)
+		return;
+	_startingQueuedSyncs = YES;
+
+	while (_syncQueueHead < _syncQueue.count && (NSInteger)_syncsInFlight.count < _maxConcurrentSyncs) {
+
+		id<MMMLoadable> loadable = _syncQueue[_syncQueueHead++];
+
+		if (![self MMMPureLoadableGroup_containsLoadable:loadable])
+			continue;
+
+		// Marking it before starting, so we know it's ours when it notifies.
+		[_syncsInFlight addObject:loadable];
+		if (_syncQueueForced)
+			[loadable sync];
+		else
+			[loadable syncIfNeeded];
+
+		// Did not need a sync or was done right away.
+		if (loadable.loadableState != MMMLoadableStateSyncing)
+			[_syncsInFlight removeObject:loadable];
+	}
+
+	if (_syncQueueHead >= _syncQueue.count) {
+		_syncQueue = nil;
+		_syncQueueHead = 0;
+	}
+
+	_startingQueuedSyncs = NO;
+}
+
+- (void)MMMPureLoadableGroup_childDidChange:(id<MMMPureLoadable>)loadable {
+
+	// The race is over, no need to wait for the rest.
+	if (_cancelsLosers
+		&& !_cancelLosersScheduled
+		&& loadable.loadableState == MMMLoadableStateDidSyncSuccessfully
+		&& [self MMMPureLoadableGroup_hasEnoughSuccesses]
+	) {
+		// Not cancelling right away: we are in the middle of the notification of the winner, which the rest of
+		// its observers have not seen yet, and cancelling would notify us about the losers re-entrantly.
+		// Whatever is still waiting in the queue is not needed though and can be dropped now.
+		_syncQueue = nil;
+		_syncQueueHead = 0;
+		_cancelLosersScheduled = YES;
+		__weak MMMLoadableGroup *weakSelf = self;
+		dispatch_async(dispatch_get_main_queue(), ^{
+			[weakSelf cancelLosers];
+		});
+	}
+
+	// Starting the next one before the group updates its state, so it does not appear idle in between.
+	if (loadable.loadableState != MMMLoadableStateSyncing && [_syncsInFlight containsObject:loadable]) {
+		[_syncsInFlight removeObject:loadable];
+		[self startQueuedSyncs];
+	}
 }
 
 @end
@@ -787,7 +2427,10 @@ NSString *NSStringFromMMMLoadableState(MMMLoadableState state) {
 @interface MMMPureLoadableProxy () <MMMLoadableObserver>
 @end
 
-@implementation MMMPureLoadableProxy
+@implementation MMMPureLoadableProxy {
+	// The generation of the proxied object as of the last notification from it.
+	uint64_t _loadableGeneration;
+}
 
 - (void)dealloc {
 	[_loadable removeObserver:self];
@@ -812,9 +2455,15 @@ NSString *NSStringFromMMMLoadableState(MMMLoadableState state) {
 	_loadable = l;
 	[_loadable addObserver:self];
 
+	_loadableGeneration = [self generationOfLoadable:_loadable];
+
 	// We need to reset our loadable state only when the proxied object is removed (not sure if it's the actual use case).
 	// But resetting it also triggers a notification and that's what we need in any case.
-	super.loadableState = MMMLoadableStateIdle;
+	[self MMMLoadable_setLoadableStateForcingChange:MMMLoadableStateIdle];
+}
+
+- (uint64_t)generationOfLoadable:(id<MMMPureLoadable>)loadable {
+	return [loadable respondsToSelector:@selector(changeGeneration)] ? loadable.changeGeneration : 0;
 }
 
 - (void)proxyDidChange {
@@ -826,7 +2475,14 @@ NSString *NSStringFromMMMLoadableState(MMMLoadableState state) {
 }
 
 - (void)loadableDidChange:(id<MMMPureLoadable>)loadable {
-	[self notifyDidChange];
+	// Passing the generation through, unless the proxied object does not support it (and it's always 0 then).
+	uint64_t generation = [self generationOfLoadable:_loadable];
+	if (generation != 0 && generation == _loadableGeneration) {
+		[self MMMLoadable_notifyDidChangeUnchanged];
+	} else {
+		_loadableGeneration = generation;
+		[self notifyDidChange];
+	}
 }
 
 @end
@@ -837,7 +2493,10 @@ NSString *NSStringFromMMMLoadableState(MMMLoadableState state) {
 @interface MMMLoadableProxy () <MMMLoadableObserver>
 @end
 
-@implementation MMMLoadableProxy
+@implementation MMMLoadableProxy {
+	// The generation of the proxied object as of the last notification from it.
+	uint64_t _loadableGeneration;
+}
 
 - (void)dealloc {
 	[_loadable removeObserver:self];
@@ -869,9 +2528,15 @@ NSString *NSStringFromMMMLoadableState(MMMLoadableState state) {
 	// And adding our observer after requesting sync, so we skip the first notification if any.
 	[_loadable addObserver:self];
 
+	_loadableGeneration = [self generationOfLoadable:_loadable];
+
 	// We need to reset our loadable state only when the proxied object is removed (not sure if it's the actual use case).
 	// But resetting it also triggers a notification and that's what we need in any case.
-	super.loadableState = MMMLoadableStateIdle;
+	[self MMMLoadable_setLoadableStateForcingChange:MMMLoadableStateIdle];
+}
+
+- (uint64_t)generationOfLoadable:(id<MMMPureLoadable>)loadable {
+	return [loadable respondsToSelector:@selector(changeGeneration)] ? loadable.changeGeneration : 0;
 }
 
 - (void)proxyDidChange {
@@ -883,7 +2548,14 @@ NSString *NSStringFromMMMLoadableState(MMMLoadableState state) {
 }
 
 - (void)loadableDidChange:(id<MMMPureLoadable>)loadable {
-	[self notifyDidChange];
+	// Passing the generation through, unless the proxied object does not support it (and it's always 0 then).
+	uint64_t generation = [self generationOfLoadable:_loadable];
+	if (generation != 0 && generation == _loadableGeneration) {
+		[self MMMLoadable_notifyDidChangeUnchanged];
+	} else {
+		_loadableGeneration = generation;
+		[self notifyDidChange];
+	}
 }
 
 - (BOOL)needsSync {
@@ -898,22 +2570,196 @@ NSString *NSStringFromMMMLoadableState(MMMLoadableState state) {
 	[self.loadable sync];
 }
 
+- (void)cancelSync {
+	if (_loadable) {
+		if ([_loadable respondsToSelector:@selector(cancelSync)])
+			[_loadable cancelSync];
+	} else {
+		// Nothing to forward to yet, but the pending sync should not be started when the actual object is set.
+		[super cancelSync];
+	}
+}
+
+@end
+
+#pragma mark - MMMLoadableRegistry
+
+//
+// What the registry remembers about each key: the loadable while it's alive and its cost in the cache,
+// so the loadable keeps the cost when it's put back into the cache after being evicted.
+//
+@interface MMMLoadableRegistryEntry : NSObject {
+@public
+	__weak id _loadable;
+	NSUInteger _cost;
+}
+@end
+
+@implementation MMMLoadableRegistryEntry
+@end
+
+/// The registry is never purged of dead entries while it has fewer than this many of them.
+static NSUInteger const MMMLoadableRegistryMinPurgeCount = 64;
+
+@implementation MMMLoadableRegistry {
+	os_unfair_lock _lock;
+	// All the loadables that are still alive, regardless of what the cache has evicted,
+	// plus the entries of the dead ones that have not been purged yet.
+	NSMapTable<id, MMMLoadableRegistryEntry *> *_entries;
+	// The dead entries are purged when the number of entries reaches this.
+	NSUInteger _purgeCount;
+}
+
+- (id)initWithCache:(NSCache *)cache {
+
+	if (self = [super init]) {
+		_cache = cache;
+		_lock = OS_UNFAIR_LOCK_INIT;
+		_entries = [NSMapTable strongToStrongObjectsMapTable];
+		_purgeCount = MMMLoadableRegistryMinPurgeCount;
+	}
+
+	return self;
+}
+
+- (id)init {
+	return [self initWithCache:nil];
+}
+
+/// The live loadable for the key, forgetting the entry if the loadable is gone. (Under the lock.)
+- (id)liveLoadableForKey:(id)key cost:(NSUInteger *)cost {
+
+	MMMLoadableRegistryEntry *entry = [_entries objectForKey:key];
+	if (!entry)
+		return nil;
+
+	id loadable = entry->_loadable;
+	if (!loadable) {
+		[_entries removeObjectForKey:key];
+		return nil;
+	}
+
+	if (cost)
+		*cost = entry->_cost;
+	return loadable;
+}
+
+/// (Under the lock.)
+- (void)registerLoadable:(id)loadable forKey:(id)key {
+
+	MMMLoadableRegistryEntry *entry = [[MMMLoadableRegistryEntry alloc] init];
+	entry->_loadable = loadable;
+	[_entries setObject:entry forKey:key];
+
+	// Dead entries of the keys that are never asked for again are purged once their number doubles,
+	// so the sweep costs O(1) per insertion on average.
+	if (_entries.count >= _purgeCount) {
+		NSMutableArray *deadKeys = [[NSMutableArray alloc] init];
+		for (id k in _entries) {
+			MMMLoadableRegistryEntry *e = [_entries objectForKey:k];
+			if (!e->_loadable)
+				[deadKeys addObject:k];
+		}
+		for (id k in deadKeys) {
+			[_entries removeObjectForKey:k];
+		}
+		_purgeCount = MAX(MMMLoadableRegistryMinPurgeCount, _entries.count * 2);
+	}
+}
+
+- (id)loadableForKey:(id)key {
+
+	// The cache is checked first, so the recently used objects are marked as such.
+	id loadable = [_cache objectForKey:key];
+	if (loadable)
+		return loadable;
+
+	NSUInteger cost = 0;
+	os_unfair_lock_lock(&_lock);
+	loadable = [self liveLoadableForKey:key cost:&cost];
+	os_unfair_lock_unlock(&_lock);
+
+	if (loadable) {
+		// Still in use, but was evicted from the cache. Let's put it back there as it's popular.
+		[_cache setObject:loadable forKey:key cost:cost];
+	}
+
+	return loadable;
+}
+
+- (id)loadableForKey:(id)key factory:(NS_NOESCAPE id (^)(void))factory {
+
+	id loadable = [self loadableForKey:key];
+	if (loadable)
+		return loadable;
+
+	// Not calling the factory under the lock, as it can be arbitrarily complex.
+	loadable = factory();
+
+	NSUInteger cost = 0;
+	os_unfair_lock_lock(&_lock);
+	// Somebody could have registered an object for the same key meanwhile (only possible with several threads).
+	id existing = [self liveLoadableForKey:key cost:&cost];
+	if (existing)
+		loadable = existing;
+	else
+		[self registerLoadable:loadable forKey:key];
+	os_unfair_lock_unlock(&_lock);
+
+	[_cache setObject:loadable forKey:key cost:cost];
+
+	return loadable;
+}
+
+- (void)setLoadable:(id)loadable forKey:(id)key {
+
+	os_unfair_lock_lock(&_lock);
+	[self registerLoadable:loadable forKey:key];
+	os_unfair_lock_unlock(&_lock);
+
+	[_cache setObject:loadable forKey:key];
+}
+
+- (void)setCost:(NSUInteger)cost forKey:(id)key {
+
+	os_unfair_lock_lock(&_lock);
+	id loadable = [self liveLoadableForKey:key cost:NULL];
+	if (loadable)
+		((MMMLoadableRegistryEntry *)[_entries objectForKey:key])->_cost = cost;
+	os_unfair_lock_unlock(&_lock);
+
+	if (loadable)
+		[_cache setObject:loadable forKey:key cost:cost];
+}
+
+- (NSUInteger)entryCount {
+	os_unfair_lock_lock(&_lock);
+	NSUInteger result = _entries.count;
+	os_unfair_lock_unlock(&_lock);
+	return result;
+}
+
 @end
 
 //
 //
 //
+@interface MMMTestLoadable () <MMMLoadableBatchable>
+@end
+
 @implementation MMMTestLoadable {
-	MMMObserverHub<id<MMMLoadableObserver>> *_observerHub;
+	MMMLoadableObserverList _observers;
+	uint64_t _changeGeneration;
 }
 
 @synthesize loadableState = _loadableState;
 
 - (id)init {
-	if (self = [super init]) {
-		_observerHub = [[MMMObserverHub alloc] initWithObservable:self];
-	}
-	return self;
+	return [super init];
+}
+
+- (void)dealloc {
+	MMMLoadableObserverListFree(&_observers);
 }
 
 - (BOOL)needsSync {
@@ -935,6 +2781,14 @@ NSString *NSStringFromMMMLoadableState(MMMLoadableState state) {
 	// Don't have to do anything here, subclasses might override this.
 }
 
+- (void)cancelSync {
+
+	_cancelSyncCounter++;
+
+	if (self.loadableState == MMMLoadableStateSyncing)
+		[self setIdle];
+}
+
 - (void)sync {
 
 	_syncCounter++;
@@ -952,9 +2806,15 @@ NSString *NSStringFromMMMLoadableState(MMMLoadableState state) {
 	return _contentsAvailable;
 }
 
+- (uint64_t)changeGeneration {
+	// Our "did change" is sent even when nothing has changed, so every notification is a new generation.
+	return _changeGeneration;
+}
+
 - (void)resetAllCallCounters {
 	_syncIfNeededCounter = 0;
 	_syncCounter = 0;
+	_cancelSyncCounter = 0;
 	_isContentsAvailableCounter = 0;
 }
 
@@ -984,23 +2844,30 @@ NSString *NSStringFromMMMLoadableState(MMMLoadableState state) {
 #pragma mark -
 
 - (BOOL)hasObservers {
-	return !_observerHub.empty;
+	return !MMMLoadableObserverListIsEmpty(&_observers);
 }
 
 - (void)notifyDidChange {
-	[_observerHub forEachObserver:^(id<MMMLoadableObserver> observer) {
-		[observer loadableDidChange:self];
-	}];
+
+	_changeGeneration++;
+
+	if (MMMLoadableBatchDefer(self))
+		return;
+	[self MMMLoadable_notifyObservers];
+}
+
+- (void)MMMLoadable_notifyObservers {
+	MMMLoadableObserverListNotify(&_observers, self);
 }
 
 - (void)addObserver:(id<MMMLoadableObserver>)observer {
 	_addObserverCounter++;
-	[_observerHub addObserver:observer];
+	MMMLoadableObserverListAdd(&_observers, observer);
 }
 
 - (void)removeObserver:(id<MMMLoadableObserver>)observer {
 	_removeObserverCounter--;
-	[_observerHub removeObserver:observer];
+	MMMLoadableObserverListRemove(&_observers, observer);
 }
 
 @end
@@ -121,41 +121,47 @@
 	UIImage *_image;
 	NSURLSession *_session;
 	NSURLSessionTask *_downloadTask;
+	// Bumped on every sync and cancellation, so the late results of the previous syncs can be told apart.
+	// (Touched on the main thread only.)
+	NSUInteger _syncToken;
 }
 
 @synthesize image=_image;
 
 // TODO: this is not nice: without the cache the image could be reused in MMMTemple
 
-+ (NSCache *)cache {
++ (MMMLoadableRegistry<id, MMMPublicLoadableImage *> *)registry {
 
 	static dispatch_once_t onceToken;
-	static NSCache *cache = nil;
+	static MMMLoadableRegistry *registry = nil;
 	dispatch_once(&onceToken, ^{
-		cache = [[NSCache alloc] init];
+		NSCache *cache = [[NSCache alloc] init];
 		// Max 100 images
 		cache.countLimit = 100;
 		// Max 1 Mpixel
 		cache.totalCostLimit = 100 * 100 * 100;
+		// The images evicted from the cache are still found in the registry while in use,
+		// so there is only one download per URL at a time.
+		registry = [[MMMLoadableRegistry alloc] initWithCache:cache];
 	});
 
-	return cache;
+	return registry;
 }
 
 - (id)initWithURL:(NSURL *)url {
 
 	id cacheKey = url ?: [NSNull null];
 
-	id cachedInstance = [[MMMPublicLoadableImage cache] objectForKey:cacheKey];
-	if (cachedInstance)
-		return cachedInstance;
+	id existingInstance = [[MMMPublicLoadableImage registry] loadableForKey:cacheKey];
+	if (existingInstance)
+		return existingInstance;
 
 	if (self = [super init]) {
 		_url = url;
 		_session = [NSURLSession sharedSession];
 	}
 
-	[[MMMPublicLoadableImage cache] setObject:self forKey:cacheKey cost:0];
+	[[MMMPublicLoadableImage registry] setLoadable:self forKey:cacheKey];
 
 	return self;
 }
@@ -170,25 +176,45 @@
 
 - (void)doSync {
 
+	NSUInteger token = ++_syncToken;
+
 	if (!_url) {
-		[self didFailWithError:[self errorWithMessage:@"No URL provided"]];
+		[self didFailWithError:[self errorWithMessage:@"No URL provided"] token:token];
 		return;
 	}
 
+	NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:_url];
+	if (self.syncDeadline > 0) {
+		// No need to wait for the network longer than the sync is allowed to take.
+		request.timeoutInterval = MAX(self.syncDeadline - self.timeSource(), 1);
+	}
+
 	_downloadTask = [_session
-		dataTaskWithURL:_url
+		dataTaskWithRequest:request
 		completionHandler:^(NSData *data, NSURLResponse *response, NSError *error) {
+			if ([error.domain isEqualToString:NSURLErrorDomain] && error.code == NSURLErrorCancelled)
+				return; // Via `doCancelSync`, nobody is waiting for it.
 			if (error)
-				[self didFailWithError:error];
+				[self didFailWithError:error token:token];
 			else
-				[self didFinishSuccessfullyWithResponse:response data:data];
+				[self didFinishSuccessfullyWithResponse:response data:data token:token];
 		}
 	];
 	[_downloadTask resume];
 }
 
-- (void)dispatch:(void (^)(void))block {
-	dispatch_async(dispatch_get_main_queue(), block);
+- (void)doCancelSync {
+	_syncToken++;
+	[_downloadTask cancel];
+	_downloadTask = nil;
+}
+
+- (void)dispatch:(void (^)(void))block token:(NSUInteger)token {
+	dispatch_async(dispatch_get_main_queue(), ^{
+		// The results of a sync that has been cancelled or superseded by another one meanwhile are not needed.
+		if (token == self->_syncToken && self.loadableState == MMMLoadableStateSyncing)
+			block();
+	});
 }
 
 - (NSError *)errorWithMessage:(NSString *)message {
@@ -208,24 +234,24 @@
 	[super setFailedToSyncWithError:error];
 }
 
-- (void)didFailWithError:(NSError *)error {
+- (void)didFailWithError:(NSError *)error token:(NSUInteger)token {
 
 	[self dispatch:^{
 		[self setFailedToSyncWithError:error];
-	}];
+	} token:token];
 }
 
-- (void)didFinishSuccessfullyWithResponse:(NSURLResponse *)response data:(NSData *)data {
+- (void)didFinishSuccessfullyWithResponse:(NSURLResponse *)response data:(NSData *)data token:(NSUInteger)token {
 
 	NSAssert(![NSThread isMainThread], @"");
 
 	if (!response) {
-		[self didFailWithError:[self errorWithMessage:@"No response"]];
+		[self didFailWithError:[self errorWithMessage:@"No response"] token:token];
 		return;
 	}
 
 	if (!data || [data length] == 0) {
-		[self didFailWithError:[self errorWithMessage:@"Empty response"]];
+		[self didFailWithError:[self errorWithMessage:@"Empty response"] token:token];
 		return;
 	}
 
@@ -237,7 +263,7 @@
 
 		[self didFailWithError:[self errorWithMessage:[NSString
 			stringWithFormat:@"Unsupported MIME type: '%@'", [response MIMEType]
-		]]];
+		]] token:token];
 
 		return;
 	}
@@ -248,25 +274,25 @@
 		MMM_LOG_TRACE(@"Successfully fetched a %ldx%ld image from %@", (long)image.size.width, (long)image.size.height, _url);
 
 		// Now we know the size of the image, let's update the cost in the cache.
-		[[MMMPublicLoadableImage cache] setObject:self forKey:_url cost:image.size.width * image.size.height];
+		[[MMMPublicLoadableImage registry] setCost:image.size.width * image.size.height forKey:_url];
 
 		[[MMMNetworkConditioner shared]
 			conditionBlock:^(NSError *error) {
 				[self dispatch:^{
 					if (error) {
-						[self didFailWithError:error];
+						[self didFailWithError:error token:token];
 					} else {
 						self->_image = image;
 						self.loadableState = MMMLoadableStateDidSyncSuccessfully;
 					}
-				}];
+				} token:token];
 			}
 			inContext:NSStringFromClass(self.class)
 			estimatedResponseLength:data.length
 		];
 
 	} else {
-		[self didFailWithError:[self errorWithMessage:@"Could not decode the image data"]];
+		[self didFailWithError:[self errorWithMessage:@"Could not decode the image data"] token:token];
 	}
 }
 
@@ -0,0 +1,151 @@
+//
+// MMMLoadable. Part of MMMTemple.
+// Copyright (C) 2016-2020 MediaMonks. All rights reserved.
+//
+
+import MMMLoadable
+import XCTest
+
+class MMMAutosyncSchedulerTestCase: XCTestCase {
+
+	private class TestLoadable: MMMAutosyncLoadable {
+
+		var syncCount = 0
+
+		override func doSync() {
+			syncCount += 1
+		}
+
+		override var isContentsAvailable: Bool { false }
+	}
+
+	/// A reference, because the internal timer of the scheduler can outlive the test.
+	private class Clock {
+		var now: TimeInterval = 1000
+	}
+
+	private var clock: Clock!
+	private var scheduler: MMMAutosyncScheduler!
+
+	override func setUp() {
+		super.setUp()
+		let clock = Clock()
+		self.clock = clock
+		scheduler = MMMAutosyncScheduler(timeSource: { clock.now })
+	}
+
+	override func tearDown() {
+		scheduler = nil
+		clock = nil
+		super.tearDown()
+	}
+
+	private func advance(to time: TimeInterval) {
+		clock.now = time
+		scheduler.fireDueEntries()
+	}
+
+	func testScheduling() {
+
+		let a = TestLoadable()
+		let b = TestLoadable()
+		scheduler.scheduleTarget(a, after: 10)
+		scheduler.scheduleTarget(b, after: 20.5)
+
+		advance(to: 1009.5)
+		XCTAssertEqual([a.syncCount, b.syncCount], [0, 0])
+
+		advance(to: 1010)
+		XCTAssertEqual([a.syncCount, b.syncCount], [1, 0])
+
+		// Never earlier than asked for, i.e. rounded up to the next tick.
+		advance(to: 1020.5)
+		XCTAssertEqual([a.syncCount, b.syncCount], [1, 0])
+		advance(to: 1021)
+		XCTAssertEqual([a.syncCount, b.syncCount], [1, 1])
+
+		// Fired entries are not fired again.
+		advance(to: 2000)
+		XCTAssertEqual([a.syncCount, b.syncCount], [1, 1])
+	}
+
+	func testRescheduling() {
+
+		let a = TestLoadable()
+
+		// This is what the loadables do when their state changes: cancel the old timer, schedule a new one.
+		let entry = scheduler.scheduleTarget(a, after: 10)
+		advance(to: 1005)
+		scheduler.cancel(entry)
+		scheduler.scheduleTarget(a, after: 10)
+
+		advance(to: 1010)
+		XCTAssertEqual(a.syncCount, 0)
+
+		advance(to: 1015)
+		XCTAssertEqual(a.syncCount, 1)
+	}
+
+	func testCancelling() {
+
+		let a = TestLoadable()
+		let b = TestLoadable()
+		let entryA = scheduler.scheduleTarget(a, after: 10)
+		scheduler.scheduleTarget(b, after: 10)
+
+		scheduler.cancel(entryA)
+		// Cancelling twice or after firing is fine.
+		scheduler.cancel(entryA)
+		scheduler.cancel(nil)
+
+		advance(to: 1010)
+		XCTAssertEqual([a.syncCount, b.syncCount], [0, 1])
+	}
+
+	func testMoreThanOneRevolution() {
+
+		// The wheel has 64 one-second slots, so these two share the same slot.
+		let short = TestLoadable()
+		let long = TestLoadable()
+		scheduler.scheduleTarget(long, after: 100)
+		scheduler.scheduleTarget(short, after: 36)
+
+		advance(to: 1036)
+		XCTAssertEqual([short.syncCount, long.syncCount], [1, 0])
+
+		advance(to: 1099)
+		XCTAssertEqual([short.syncCount, long.syncCount], [1, 0])
+
+		advance(to: 1100)
+		XCTAssertEqual([short.syncCount, long.syncCount], [1, 1])
+
+		// Also when the time jumps over several revolutions at once.
+		let veryLong = TestLoadable()
+		let cancelled = TestLoadable()
+		scheduler.scheduleTarget(veryLong, after: 200)
+		let entry = scheduler.scheduleTarget(cancelled, after: 264)
+		scheduler.cancel(entry)
+
+		advance(to: 1250)
+		XCTAssertEqual(veryLong.syncCount, 0)
+
+		advance(to: 1500)
+		XCTAssertEqual([veryLong.syncCount, cancelled.syncCount], [1, 0])
+	}
+
+	func testCancellingEarliestInSlot() {
+
+		// Again sharing a slot; cancelling the earlier one should leave the later one the earliest in it.
+		let short = TestLoadable()
+		let long = TestLoadable()
+		let entry = scheduler.scheduleTarget(short, after: 36)
+		scheduler.scheduleTarget(long, after: 100)
+		scheduler.cancel(entry)
+
+		advance(to: 1036)
+		XCTAssertEqual([short.syncCount, long.syncCount], [0, 0])
+
+		advance(to: 1100)
+		XCTAssertEqual([short.syncCount, long.syncCount], [0, 1])
+	}
+}
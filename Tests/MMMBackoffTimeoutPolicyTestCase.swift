@@ -0,0 +1,44 @@
+//
+// MMMLoadable. Part of MMMTemple.
+// Copyright (C) 2016-2020 MediaMonks. All rights reserved.
+//
+
+import MMMLoadable
+import XCTest
+
+class MMMBackoffTimeoutPolicyTestCase: XCTestCase {
+
+	private func timeouts(_ jitter: MMMBackoffTimeoutPolicy.Jitter, seed: UInt64 = 1) -> [TimeInterval] {
+		let policy = MMMBackoffTimeoutPolicy(
+			min: 1, max: 16, multiplier: 2,
+			jitter: jitter,
+			randomSource: MMMSeededRandomNumberGenerator(seed: seed)
+		)
+		return (0..<8).map { _ in policy.nextTimeout(afterFailure: true) }
+	}
+
+	func testNoJitter() {
+		XCTAssertEqual(timeouts(.none), [1, 2, 4, 8, 16, 16, 16, 16])
+	}
+
+	func testJitter() {
+
+		let exponential = timeouts(.none)
+
+		for (full, upper) in zip(timeouts(.full), exponential) {
+			XCTAssert(0 <= full && full <= upper)
+		}
+
+		for (equal, upper) in zip(timeouts(.equal), exponential) {
+			XCTAssert(upper / 2 <= equal && equal <= upper)
+		}
+
+		for decorrelated in timeouts(.decorrelated) {
+			XCTAssert(1 <= decorrelated && decorrelated <= 16)
+		}
+
+		// Same seed, same schedule.
+		XCTAssertEqual(timeouts(.decorrelated, seed: 42), timeouts(.decorrelated, seed: 42))
+		XCTAssertNotEqual(timeouts(.full, seed: 1), timeouts(.full, seed: 2))
+	}
+}
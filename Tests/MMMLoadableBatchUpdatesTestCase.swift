@@ -0,0 +1,59 @@
+//
+// MMMLoadable. Part of MMMTemple.
+// Copyright (C) 2016-2020 MediaMonks. All rights reserved.
+//
+
+import MMMLoadable
+import XCTest
+
+class MMMLoadableBatchUpdatesTestCase: XCTestCase {
+
+	func testCoalescing() {
+
+		let a = MMMTestLoadable()
+		let b = MMMTestLoadable()
+		let group = MMMPureLoadableGroup(loadables: [a, b])
+
+		var aCount = 0
+		let aObserver = MMMLoadableObserver(loadable: a) { _ in aCount += 1 }
+		var groupCount = 0
+		let groupObserver = MMMLoadableObserver(loadable: group) { _ in groupCount += 1 }
+
+		group.performBatchUpdates {
+			a.setSyncing()
+			b.setSyncing()
+			a.setDidSyncSuccessfully()
+			b.setDidSyncSuccessfully()
+			XCTAssertEqual(aCount, 0)
+			XCTAssertEqual(groupCount, 0)
+		}
+
+		XCTAssertEqual(aCount, 1)
+		XCTAssertEqual(groupCount, 1)
+		XCTAssertEqual(group.loadableState, .didSyncSuccessfully)
+
+		// Nothing should be postponed outside of a batch.
+		a.setSyncing()
+		XCTAssertEqual(aCount, 2)
+
+		withExtendedLifetime([aObserver, groupObserver]) {}
+	}
+
+	func testNesting() {
+
+		let a = MMMTestLoadable()
+		var count = 0
+		let observer = MMMLoadableObserver(loadable: a) { _ in count += 1 }
+
+		MMMLoadablePerformBatchUpdates {
+			a.setSyncing()
+			MMMLoadablePerformBatchUpdates {
+				a.setDidSyncSuccessfully()
+			}
+			XCTAssertEqual(count, 0)
+		}
+		XCTAssertEqual(count, 1)
+
+		withExtendedLifetime(observer) {}
+	}
+}
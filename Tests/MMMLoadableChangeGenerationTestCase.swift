@@ -0,0 +1,38 @@
+//
+// MMMLoadable. Part of MMMTemple.
+// Copyright (C) 2016-2020 MediaMonks. All rights reserved.
+//
+
+import MMMLoadable
+import XCTest
+
+class MMMLoadableChangeGenerationTestCase: XCTestCase {
+
+	func testRedundantChangesAreSkipped() {
+
+		let loadable = MMMPureLoadable()
+
+		var count = 0
+		let observer = MMMLoadableObserver(loadable: loadable) { _ in count += 1 }
+		observer?.skipsUnchanged = true
+
+		let initial = loadable.changeGeneration
+
+		loadable.setSyncing()
+		XCTAssertEqual(count, 1)
+		XCTAssertNotEqual(loadable.changeGeneration, initial)
+
+		// Nothing has changed, thus same generation and no notification.
+		let syncing = loadable.changeGeneration
+		loadable.setSyncing()
+		XCTAssertEqual(loadable.changeGeneration, syncing)
+		XCTAssertEqual(count, 1)
+
+		// Setting 'did sync' again can mean new contents though.
+		loadable.setDidSyncSuccessfully()
+		loadable.setDidSyncSuccessfully()
+		XCTAssertEqual(count, 3)
+
+		withExtendedLifetime(observer) {}
+	}
+}
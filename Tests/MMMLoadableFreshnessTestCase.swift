@@ -0,0 +1,85 @@
+//
+// MMMLoadable. Part of MMMTemple.
+// Copyright (C) 2016-2020 MediaMonks. All rights reserved.
+//
+
+import MMMLoadable
+import XCTest
+
+class MMMLoadableFreshnessTestCase: XCTestCase {
+
+	private class TestLoadable: MMMLoadable {
+
+		var syncCount = 0
+		var contents: Int?
+
+		override func doSync() {
+			syncCount += 1
+		}
+
+		override var isContentsAvailable: Bool { contents != nil }
+	}
+
+	func testStaleWhileRevalidate() {
+
+		var now: TimeInterval = 1000
+
+		let loadable = TestLoadable()
+		loadable.timeSource = { now }
+		loadable.maxAge = 10
+		loadable.staleWhileRevalidate = 20
+		XCTAssertEqual(loadable.freshness, .expired)
+
+		loadable.syncIfNeeded()
+		loadable.contents = 1
+		loadable.setDidSyncSuccessfully()
+		XCTAssertEqual(loadable.syncCount, 1)
+		XCTAssertEqual(loadable.lastSyncTime, 1000)
+
+		// Fresh enough, nothing to do.
+		now += 5
+		XCTAssertEqual(loadable.freshness, .fresh)
+		loadable.syncIfNeeded()
+		XCTAssertEqual(loadable.syncCount, 1)
+
+		// Stale: one refresh, while the contents remain available.
+		now += 10
+		XCTAssertEqual(loadable.freshness, .stale)
+		loadable.syncIfNeeded()
+		loadable.syncIfNeeded()
+		XCTAssertEqual(loadable.syncCount, 2)
+		XCTAssert(loadable.isContentsAvailable)
+
+		now += 30
+		XCTAssertEqual(loadable.freshness, .expired)
+
+		loadable.setDidSyncSuccessfully()
+		XCTAssertEqual(loadable.freshness, .fresh)
+	}
+
+	func testOnlyCompletedSyncsCount() {
+
+		// Zero is a valid time and should not be confused with "never synced".
+		var now: TimeInterval = 0
+
+		let loadable = TestLoadable()
+		loadable.timeSource = { now }
+		loadable.maxAge = 10
+
+		// Not a sync, just a subclass signalling new contents.
+		loadable.contents = 1
+		loadable.setDidSyncSuccessfully()
+		XCTAssertEqual(loadable.freshness, .expired)
+
+		loadable.sync()
+		loadable.setDidSyncSuccessfully()
+		XCTAssertEqual(loadable.lastSyncTime, 0)
+		XCTAssertEqual(loadable.freshness, .fresh)
+
+		// Repeating 'did sync successfully' does not make the contents any fresher.
+		now += 15
+		loadable.setDidSyncSuccessfully()
+		XCTAssertEqual(loadable.lastSyncTime, 0)
+		XCTAssertEqual(loadable.freshness, .expired)
+	}
+}
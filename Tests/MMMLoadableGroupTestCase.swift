@@ -0,0 +1,262 @@
+//
+// MMMLoadable. Part of MMMTemple.
+// Copyright (C) 2016-2020 MediaMonks. All rights reserved.
+//
+
+import MMMLoadable
+import XCTest
+
+class MMMLoadableGroupTestCase: XCTestCase {
+
+	func testRacePolicy() {
+
+		let a = MMMTestLoadable()
+		let b = MMMTestLoadable()
+		let group = MMMLoadableGroup(loadables: [a, b], failurePolicy: .race)
+
+		a.setSyncing()
+		b.setSyncing()
+		XCTAssertEqual(group.loadableState, .syncing)
+
+		// A failure alone does not fail the group while others are still trying.
+		a.setDidFailToSyncWithError(nil)
+		XCTAssertEqual(group.loadableState, .syncing)
+		XCTAssertNil(group.raceWinner)
+
+		// The first success wins.
+		b.contentsAvailable = true
+		b.setDidSyncSuccessfully()
+		XCTAssertEqual(group.loadableState, .didSyncSuccessfully)
+		XCTAssert(group.isContentsAvailable)
+		XCTAssert(group.raceWinner === b)
+
+		// And the group fails only when everyone fails.
+		b.contentsAvailable = false
+		b.setDidFailToSyncWithError(nil)
+		XCTAssertEqual(group.loadableState, .didFailToSync)
+		XCTAssertFalse(group.isContentsAvailable)
+	}
+
+	func testQuorumPolicy() {
+
+		let loadables = (0..<4).map { _ in MMMTestLoadable() }
+		let group = MMMLoadableGroup(loadables: loadables, quorum: 2)
+
+		loadables.forEach { $0.setSyncing() }
+		XCTAssertEqual(group.loadableState, .syncing)
+
+		loadables[0].contentsAvailable = true
+		loadables[0].setDidSyncSuccessfully()
+		loadables[1].setDidFailToSyncWithError(nil)
+		XCTAssertEqual(group.loadableState, .syncing)
+
+		// 2 of 4 are enough, no need to wait for the last one.
+		loadables[2].contentsAvailable = true
+		loadables[2].setDidSyncSuccessfully()
+		XCTAssertEqual(group.loadableState, .didSyncSuccessfully)
+		XCTAssert(group.isContentsAvailable)
+
+		// 3 failures out of 4 mean 2 successes are not possible anymore.
+		loadables[2].contentsAvailable = false
+		loadables[2].setDidFailToSyncWithError(nil)
+		XCTAssertEqual(group.loadableState, .syncing)
+		loadables[0].contentsAvailable = false
+		loadables[0].setDidFailToSyncWithError(nil)
+		XCTAssertEqual(group.loadableState, .didFailToSync)
+	}
+
+	func testFailedLoadablesAndError() {
+
+		let a = MMMTestLoadable()
+		let b = MMMTestLoadable()
+		let group = MMMLoadableGroup(loadables: [a, b, a], failurePolicy: .never)
+
+		b.setDidFailToSyncWithError(NSError(domain: "Test", code: 2))
+		a.setDidFailToSyncWithError(NSError(domain: "Test", code: 1))
+		XCTAssertEqual(group.failedLoadables.count, 2)
+		XCTAssert(group.failedLoadables.first === b)
+
+		// Built once per failure.
+		let error = group.error
+		XCTAssertNotNil(error)
+		XCTAssert(group.error === error)
+
+		b.setDidSyncSuccessfully()
+		XCTAssertEqual(group.failedLoadables.count, 1)
+		XCTAssert(group.failedLoadables.first === a)
+		XCTAssertNotNil(group.error)
+		XCTAssert(group.error !== error)
+
+		a.setIdle()
+		XCTAssert(group.failedLoadables.isEmpty)
+		XCTAssertNil(group.error)
+	}
+
+	func testSyncFailed() {
+
+		let loadables = (0..<3).map { _ in MMMTestLoadable() }
+		let group = MMMLoadableGroup(loadables: loadables)
+
+		loadables[0].setDidSyncSuccessfully()
+		loadables[1].setDidFailToSyncWithError(nil)
+		loadables[2].setDidFailToSyncWithError(nil)
+
+		group.syncFailed()
+		XCTAssertEqual(loadables.map { $0.syncCounter }, [0, 1, 1])
+	}
+
+	func testSyncFailedSkipsPureChildren() {
+
+		let pure = MMMPureLoadable()
+		let a = MMMTestLoadable()
+		let group = MMMLoadableGroup(loadables: [pure, a], failurePolicy: .never)
+
+		pure.setFailedToSyncWithError(nil)
+		a.setDidFailToSyncWithError(nil)
+		XCTAssertEqual(group.failedLoadables.count, 2)
+
+		group.syncFailed()
+		XCTAssertEqual(a.syncCounter, 1)
+	}
+
+	func testMixedChildren() {
+
+		let pure = MMMPureLoadable()
+		let a = MMMTestLoadable()
+		let group = MMMLoadableGroup(loadables: [pure, a])
+
+		group.sync()
+		XCTAssertEqual(a.syncCounter, 1)
+
+		// Appending keeps track of which children support syncing, duplicates included.
+		let b = MMMTestLoadable()
+		group.loadables = [pure, a, b, pure, b]
+		a.setDidSyncSuccessfully()
+		group.sync()
+		XCTAssertEqual([a.syncCounter, b.syncCounter], [2, 2])
+
+		// And with no pure children left.
+		group.loadables = [a, b]
+		a.setIdle()
+		b.setIdle()
+		group.sync()
+		XCTAssertEqual([a.syncCounter, b.syncCounter], [3, 3])
+	}
+
+	func testMaxConcurrentSyncs() {
+
+		let loadables = (0..<5).map { _ in MMMTestLoadable() }
+		let group = MMMLoadableGroup(loadables: loadables)
+		group.maxConcurrentSyncs = 2
+
+		let syncingCount = { loadables.filter { $0.loadableState == .syncing }.count }
+
+		group.sync()
+		XCTAssertEqual(syncingCount(), 2)
+		XCTAssertEqual(loadables.map { $0.syncCounter }, [1, 1, 0, 0, 0])
+		XCTAssertEqual(group.loadableState, .syncing)
+
+		// Every finished child frees a slot for the next one in the queue, whatever the outcome.
+		loadables[1].setDidSyncSuccessfully()
+		XCTAssertEqual(syncingCount(), 2)
+		XCTAssertEqual(loadables.map { $0.syncCounter }, [1, 1, 1, 0, 0])
+
+		loadables[0].setDidFailToSyncWithError(nil)
+		XCTAssertEqual(syncingCount(), 2)
+		XCTAssertEqual(loadables.map { $0.syncCounter }, [1, 1, 1, 1, 0])
+
+		loadables[2].setDidSyncSuccessfully()
+		loadables[3].setDidSyncSuccessfully()
+		XCTAssertEqual(syncingCount(), 1)
+		XCTAssertEqual(loadables.map { $0.syncCounter }, [1, 1, 1, 1, 1])
+
+		// Nothing is left in the queue, so the next finish does not start anything.
+		loadables[4].setDidSyncSuccessfully()
+		XCTAssertEqual(syncingCount(), 0)
+		XCTAssertEqual(loadables.map { $0.syncCounter }, [1, 1, 1, 1, 1])
+	}
+
+	func testSyncFailedKeepsQueued() {
+
+		let loadables = (0..<4).map { _ in MMMTestLoadable() }
+		let group = MMMLoadableGroup(loadables: loadables, failurePolicy: .never)
+		group.maxConcurrentSyncs = 1
+
+		group.sync()
+		loadables[0].setDidFailToSyncWithError(nil)
+		XCTAssertEqual(loadables.map { $0.syncCounter }, [1, 1, 0, 0])
+
+		// The failed one goes after the ones still waiting, which should not be dropped.
+		group.syncFailed()
+		// Asking again should not queue anyone twice.
+		group.sync()
+		XCTAssertEqual(loadables.map { $0.syncCounter }, [1, 1, 0, 0])
+
+		loadables[1].setDidSyncSuccessfully()
+		loadables[2].setDidSyncSuccessfully()
+		loadables[3].setDidSyncSuccessfully()
+		XCTAssertEqual(loadables.map { $0.syncCounter }, [2, 1, 1, 1])
+		XCTAssertEqual(loadables[0].loadableState, .syncing)
+
+		loadables[0].setDidSyncSuccessfully()
+		XCTAssertEqual(loadables.map { $0.syncCounter }, [2, 1, 1, 1])
+	}
+
+	func testCancelSync() {
+
+		let loadables = (0..<3).map { _ in MMMTestLoadable() }
+		let group = MMMLoadableGroup(loadables: loadables)
+		group.maxConcurrentSyncs = 2
+
+		group.sync()
+		XCTAssertEqual(loadables.map { $0.loadableState }, [.syncing, .syncing, .idle])
+
+		group.cancelSync()
+		XCTAssertEqual(loadables.map { $0.cancelSyncCounter }, [1, 1, 0])
+		XCTAssertEqual(group.loadableState, .idle)
+
+		// The one waiting for its turn should not be started either.
+		loadables[0].setDidSyncSuccessfully()
+		XCTAssertEqual(loadables[2].syncCounter, 0)
+	}
+
+	func testCancelsLosers() {
+
+		let a = MMMTestLoadable()
+		let b = MMMTestLoadable()
+		let group = MMMLoadableGroup(loadables: [a, b], failurePolicy: .race)
+		group.cancelsLosers = true
+
+		group.sync()
+
+		// Everyone should learn about the winner before the losers are cancelled.
+		var winnerObserverCalls = 0
+		let winnerObserver = MMMLoadableObserver(loadable: b) { _ in
+			XCTAssertEqual(a.cancelSyncCounter, 0)
+			winnerObserverCalls += 1
+		}
+		var groupStates: [MMMLoadableState] = []
+		let groupObserver = MMMLoadableObserver(loadable: group) { _ in
+			groupStates.append(group.loadableState)
+		}
+
+		b.contentsAvailable = true
+		b.setDidSyncSuccessfully()
+		XCTAssertEqual(winnerObserverCalls, 1)
+		XCTAssertEqual(a.cancelSyncCounter, 0)
+		XCTAssertEqual(group.loadableState, .didSyncSuccessfully)
+
+		let expectation = XCTestExpectation()
+		DispatchQueue.main.async { expectation.fulfill() }
+		wait(for: [expectation], timeout: 1)
+
+		XCTAssertEqual(a.cancelSyncCounter, 1)
+		XCTAssertEqual(a.loadableState, .idle)
+		XCTAssertEqual(group.loadableState, .didSyncSuccessfully)
+		// The losers going idle should not make the group look like anything but synced.
+		XCTAssertFalse(groupStates.isEmpty)
+		XCTAssert(groupStates.allSatisfy { $0 == .didSyncSuccessfully })
+
+		withExtendedLifetime([winnerObserver, groupObserver]) {}
+	}
+}
@@ -0,0 +1,89 @@
+//
+// MMMLoadable. Part of MMMTemple.
+// Copyright (C) 2016-2020 MediaMonks. All rights reserved.
+//
+
+import MMMLoadable
+import XCTest
+
+/// Checks the inline list of observers used by the loadables before they have to switch to a hub.
+class MMMLoadableObserverListTestCase: XCTestCase {
+
+	private class Observer: NSObject, MMMLoadableObserverProtocol {
+
+		var count = 0
+		var onChange: ((Observer) -> Void)?
+
+		func loadableDidChange(_ loadable: MMMPureLoadableProtocol) {
+			count += 1
+			onChange?(self)
+		}
+	}
+
+	func testMoreThanInline() {
+
+		let loadable = MMMTestLoadable()
+		let observers = (0..<5).map { _ in Observer() }
+		observers.forEach { loadable.addObserver($0) }
+
+		loadable.setSyncing()
+		XCTAssertEqual(observers.map { $0.count }, [1, 1, 1, 1, 1])
+
+		// Removing from both the inline and the spilled parts.
+		loadable.removeObserver(observers[0])
+		loadable.removeObserver(observers[3])
+		loadable.setDidSyncSuccessfully()
+		XCTAssertEqual(observers.map { $0.count }, [1, 2, 2, 1, 2])
+
+		[1, 2, 4].forEach { loadable.removeObserver(observers[$0]) }
+		loadable.setIdle()
+		XCTAssertEqual(observers.map { $0.count }, [1, 2, 2, 1, 2])
+	}
+
+	func testRemovingWhileNotifying() {
+
+		let loadable = MMMTestLoadable()
+		let observers = (0..<4).map { _ in Observer() }
+		observers.forEach { loadable.addObserver($0) }
+
+		// The first one removes itself and the one that is not called yet.
+		observers[0].onChange = { o in
+			loadable.removeObserver(o)
+			loadable.removeObserver(observers[2])
+		}
+
+		loadable.setSyncing()
+		XCTAssertEqual(observers.map { $0.count }, [1, 1, 0, 1])
+
+		loadable.setDidSyncSuccessfully()
+		XCTAssertEqual(observers.map { $0.count }, [1, 2, 0, 2])
+
+		[1, 3].forEach { loadable.removeObserver(observers[$0]) }
+	}
+
+	func testAddingWhileNotifying() {
+
+		let loadable = MMMTestLoadable()
+		let first = Observer()
+		let added = (0..<3).map { _ in Observer() }
+		loadable.addObserver(first)
+
+		// Spilling past the inline slots in the middle of a notification.
+		first.onChange = { o in
+			o.onChange = nil
+			added.forEach { loadable.addObserver($0) }
+		}
+
+		// The added ones should be called starting from the next notification only.
+		loadable.setSyncing()
+		XCTAssertEqual(first.count, 1)
+		XCTAssertEqual(added.map { $0.count }, [0, 0, 0])
+
+		loadable.setDidSyncSuccessfully()
+		XCTAssertEqual(first.count, 2)
+		XCTAssertEqual(added.map { $0.count }, [1, 1, 1])
+
+		loadable.removeObserver(first)
+		added.forEach { loadable.removeObserver($0) }
+	}
+}
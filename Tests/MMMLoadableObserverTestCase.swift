@@ -0,0 +1,164 @@
+//
+// MMMLoadable. Part of MMMTemple.
+// Copyright (C) 2016-2020 MediaMonks. All rights reserved.
+//
+
+import MMMLoadable
+import XCTest
+
+class MMMLoadableObserverTestCase: XCTestCase {
+
+	func testEvents() {
+
+		let loadable = MMMTestLoadable()
+
+		var synced = 0
+		let syncedObserver = MMMLoadableObserver(loadable: loadable, events: .didSyncSuccessfully) { _ in synced += 1 }
+		var contents = 0
+		let contentsObserver = MMMLoadableObserver(
+			loadable: loadable,
+			events: [.contentsBecameAvailable, .contentsDidChange]
+		) { _ in contents += 1 }
+
+		loadable.setSyncing()
+		XCTAssertEqual(synced, 0)
+		XCTAssertEqual(contents, 0)
+
+		loadable.setDidSyncSuccessfully()
+		XCTAssertEqual(synced, 1)
+		XCTAssertEqual(contents, 1)
+
+		// Same state again, i.e. a change in the contents only.
+		loadable.setDidSyncSuccessfully()
+		XCTAssertEqual(synced, 1)
+		XCTAssertEqual(contents, 2)
+
+		withExtendedLifetime([syncedObserver, contentsObserver]) {}
+	}
+
+	func testMaskedEventsAreNotDelivered() {
+
+		let loadable = MMMTestLoadable()
+
+		var failed = 0
+		let failedObserver = MMMLoadableObserver(loadable: loadable, events: .didFailToSync) { _ in failed += 1 }
+		var unavailable = 0
+		let unavailableObserver = MMMLoadableObserver(
+			loadable: loadable,
+			events: .contentsBecameUnavailable
+		) { _ in unavailable += 1 }
+
+		// None of these is of interest for either observer.
+		loadable.setSyncing()
+		loadable.contentsAvailable = true
+		loadable.setDidSyncSuccessfully()
+		loadable.setDidSyncSuccessfully()
+		loadable.setIdle()
+		XCTAssertEqual(failed, 0)
+		XCTAssertEqual(unavailable, 0)
+
+		loadable.setSyncing()
+		loadable.contentsAvailable = false
+		loadable.setDidFailToSyncWithError(nil)
+		XCTAssertEqual(failed, 1)
+		XCTAssertEqual(unavailable, 1)
+
+		// Failing again with the same contents is a "contents did change" event only.
+		loadable.setDidFailToSyncWithError(nil)
+		XCTAssertEqual(failed, 1)
+		XCTAssertEqual(unavailable, 1)
+
+		withExtendedLifetime([failedObserver, unavailableObserver]) {}
+	}
+
+	func testMaskedEventsAreNotScheduled() {
+
+		let loadable = MMMTestLoadable()
+		let queue = DispatchQueue(label: "MMMLoadableObserverTestCase")
+
+		var calls = 0
+		let observer = MMMLoadableObserver(loadable: loadable, events: .didSyncSuccessfully, queue: queue) { _ in
+			calls += 1
+		}
+
+		// Filtered before going to the queue, so nothing is scheduled for these.
+		loadable.setSyncing()
+		loadable.setDidFailToSyncWithError(nil)
+		queue.sync {}
+		XCTAssertEqual(queue.sync { calls }, 0)
+
+		loadable.setDidSyncSuccessfully()
+		queue.sync {}
+		XCTAssertEqual(queue.sync { calls }, 1)
+
+		withExtendedLifetime(observer) {}
+	}
+
+	func testQueueCoalescing() {
+
+		let loadable = MMMTestLoadable()
+		let queue = DispatchQueue(label: "MMMLoadableObserverTestCase")
+
+		var calls = 0
+		let observer = MMMLoadableObserver(loadable: loadable, queue: queue) { _ in calls += 1 }
+
+		// Holding the queue, so all the changes happen before the first delivery gets a chance to run.
+		queue.suspend()
+		loadable.setSyncing()
+		loadable.setDidSyncSuccessfully()
+		loadable.notifyDidChange()
+		queue.resume()
+
+		queue.sync {}
+		XCTAssertEqual(queue.sync { calls }, 1)
+
+		// The next change after the delivery should be delivered again.
+		loadable.setIdle()
+		queue.sync {}
+		XCTAssertEqual(queue.sync { calls }, 2)
+
+		withExtendedLifetime(observer) {}
+	}
+
+	func testQueueNoDeliveryAfterRemove() {
+
+		let loadable = MMMTestLoadable()
+		let queue = DispatchQueue(label: "MMMLoadableObserverTestCase")
+
+		var calls = 0
+		let observer = MMMLoadableObserver(loadable: loadable, queue: queue) { _ in calls += 1 }
+
+		// Scheduled, but not run yet when the observer is removed.
+		queue.suspend()
+		loadable.setSyncing()
+		observer?.remove()
+		queue.resume()
+
+		queue.sync {}
+		XCTAssertEqual(queue.sync { calls }, 0)
+
+		loadable.setDidSyncSuccessfully()
+		queue.sync {}
+		XCTAssertEqual(queue.sync { calls }, 0)
+	}
+
+	func testQueueDeliversOnRequestedQueue() {
+
+		let loadable = MMMTestLoadable()
+		let queue = DispatchQueue(label: "MMMLoadableObserverTestCase")
+		let key = DispatchSpecificKey<Int>()
+		queue.setSpecific(key: key, value: 1)
+
+		let expectation = XCTestExpectation()
+		let observer = MMMLoadableObserver(loadable: loadable, queue: queue) { _ in
+			XCTAssertEqual(DispatchQueue.getSpecific(key: key), 1)
+			XCTAssertFalse(Thread.isMainThread)
+			expectation.fulfill()
+		}
+
+		loadable.setSyncing()
+		wait(for: [expectation], timeout: 1)
+
+		withExtendedLifetime(observer) {}
+	}
+}
@@ -0,0 +1,83 @@
+//
+// MMMLoadable. Part of MMMTemple.
+// Copyright (C) 2016-2020 MediaMonks. All rights reserved.
+//
+
+import MMMLoadable
+import XCTest
+
+class MMMLoadableRegistryTestCase: XCTestCase {
+
+	func testLiveInstancesAreShared() {
+
+		let cache = NSCache<NSString, MMMTestLoadable>()
+		let registry = MMMLoadableRegistry<NSString, MMMTestLoadable>(cache: cache)
+
+		var created = 0
+		let factory = { () -> MMMTestLoadable in
+			created += 1
+			return MMMTestLoadable()
+		}
+
+		let a = registry.loadable(forKey: "a", factory: factory)
+		XCTAssert(registry.loadable(forKey: "a", factory: factory) === a)
+		XCTAssertEqual(created, 1)
+
+		// Still alive, so it should be found even when the cache has evicted it.
+		cache.removeAllObjects()
+		XCTAssert(registry.loadable(forKey: "a", factory: factory) === a)
+		XCTAssertEqual(created, 1)
+
+		// Sync requests while syncing are shared.
+		a.sync()
+		registry.loadable(forKey: "a")?.sync()
+		XCTAssertEqual(a.syncCounter, 2)
+		XCTAssertEqual(a.loadableState, .syncing)
+	}
+
+	func testDeadInstancesAreForgotten() {
+
+		let registry = MMMLoadableRegistry<NSString, MMMTestLoadable>()
+
+		autoreleasepool {
+			_ = registry.loadable(forKey: "a") { MMMTestLoadable() }
+		}
+		XCTAssertNil(registry.loadable(forKey: "a"))
+		// The dead entry is forgotten on a miss.
+		XCTAssertEqual(registry.entryCount, 0)
+
+		// And the keys never asked for again are purged eventually.
+		for i in 0..<1000 {
+			autoreleasepool {
+				_ = registry.loadable(forKey: "\(i)" as NSString) { MMMTestLoadable() }
+			}
+		}
+		XCTAssertLessThan(registry.entryCount, 100)
+	}
+
+	private class CostRecordingCache: NSCache<NSString, MMMTestLoadable> {
+
+		var costs: [NSString: Int] = [:]
+
+		override func setObject(_ obj: MMMTestLoadable, forKey key: NSString, cost g: Int) {
+			costs[key] = g
+			super.setObject(obj, forKey: key, cost: g)
+		}
+	}
+
+	func testCostIsKeptWhenPutBack() {
+
+		let cache = CostRecordingCache()
+		let registry = MMMLoadableRegistry<NSString, MMMTestLoadable>(cache: cache)
+
+		let a = registry.loadable(forKey: "a") { MMMTestLoadable() }
+		registry.setCost(8, forKey: "a")
+		XCTAssertEqual(cache.costs["a"], 8)
+
+		// Evicted, but alive, so it should go back to the cache with the same cost.
+		cache.removeAllObjects()
+		cache.costs = [:]
+		XCTAssert(registry.loadable(forKey: "a") === a)
+		XCTAssertEqual(cache.costs["a"], 8)
+	}
+}
@@ -0,0 +1,94 @@
+//
+// MMMLoadable. Part of MMMTemple.
+// Copyright (C) 2016-2020 MediaMonks. All rights reserved.
+//
+
+import MMMLoadable
+import XCTest
+
+class MMMLoadableSyncTimeoutTestCase: XCTestCase {
+
+	/// Never completes on its own.
+	private class StuckLoadable: MMMLoadable {
+
+		var cancelCount = 0
+
+		override func doSync() {}
+
+		override func doCancelSync() {
+			cancelCount += 1
+		}
+
+		override var isContentsAvailable: Bool { false }
+	}
+
+	func testDeadline() {
+
+		let loadable = StuckLoadable()
+		loadable.sync(withTimeout: 0.05)
+		XCTAssertEqual(loadable.loadableState, .syncing)
+		XCTAssert(loadable.syncDeadline > 0)
+
+		let expectation = XCTestExpectation()
+		let observer = MMMLoadableObserver(loadable: loadable) { _ in
+			if loadable.loadableState == .didFailToSync {
+				expectation.fulfill()
+			}
+		}
+		wait(for: [expectation], timeout: 1)
+
+		XCTAssertEqual((loadable.error as NSError?)?.code, MMMLoadableErrorCode.syncTimedOut.rawValue)
+		XCTAssertEqual(loadable.cancelCount, 1)
+
+		// The late completion should be ignored...
+		loadable.setDidSyncSuccessfully()
+		XCTAssertEqual(loadable.loadableState, .didFailToSync)
+
+		// ...but not the next sync.
+		loadable.sync()
+		loadable.setDidSyncSuccessfully()
+		XCTAssertEqual(loadable.loadableState, .didSyncSuccessfully)
+
+		withExtendedLifetime(observer) {}
+	}
+
+	func testDeadlineFollowsTimeSource() {
+
+		var now: TimeInterval = 1000
+
+		let loadable = StuckLoadable()
+		loadable.timeSource = { now }
+		loadable.maxAge = 60
+		loadable.syncTimeout = 30
+
+		loadable.syncIfNeeded()
+		XCTAssertEqual(loadable.syncDeadline, 1030)
+
+		// Not yet, even though the timeouts of the requests could be expired in the real time.
+		now += 29
+		loadable.checkSyncDeadline()
+		XCTAssertEqual(loadable.loadableState, .syncing)
+		XCTAssertEqual(loadable.cancelCount, 0)
+
+		now += 1
+		loadable.checkSyncDeadline()
+		XCTAssertEqual(loadable.loadableState, .didFailToSync)
+		XCTAssertEqual((loadable.error as NSError?)?.code, MMMLoadableErrorCode.syncTimedOut.rawValue)
+		XCTAssertEqual(loadable.cancelCount, 1)
+		XCTAssertEqual(loadable.freshness, .expired)
+
+		// The next sync gets its own deadline and makes the contents fresh as of its completion.
+		loadable.syncIfNeeded()
+		XCTAssertEqual(loadable.syncDeadline, 1060)
+		now += 10
+		loadable.setDidSyncSuccessfully()
+		XCTAssertEqual(loadable.lastSyncTime, 1040)
+		XCTAssertEqual(loadable.freshness, .fresh)
+
+		// No longer syncing, so passing the old deadline means nothing.
+		now += 50
+		loadable.checkSyncDeadline()
+		XCTAssertEqual(loadable.loadableState, .didSyncSuccessfully)
+		XCTAssertEqual(loadable.cancelCount, 1)
+	}
+}
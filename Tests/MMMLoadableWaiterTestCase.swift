@@ -70,4 +70,43 @@ class MMMLoadableWaiterTestCase: XCTestCase {
 			XCTFail("Expected the waiting to be successful")
 		}
     }
+
+    func testCancel() {
+
+    	let cancelledIsNotCalled = expectation(description: "Cancelled request should not complete")
+    	cancelledIsNotCalled.isInverted = true
+    	let done = expectation(description: "The other request should complete")
+
+    	loadable.isContentsAvailable = false
+    	let request = loadableHasContentsAvailable.wait { _ in cancelledIsNotCalled.fulfill() }
+    	loadableHasContentsAvailable.wait { _ in done.fulfill() }
+    	request.cancel()
+
+    	loadable.isContentsAvailable = true
+    	loadable.notifyDidChange()
+		wait(for: [done, cancelledIsNotCalled], timeout: 1)
+    }
+
+    func testSynchronousFastPath() {
+
+    	loadable.isContentsAvailable = true
+
+    	var result: Result<MMMPureLoadableProtocol, Error>?
+    	let request = loadableHasContentsAvailable.wait(completingSynchronouslyIfReady: true) { result = $0 }
+    	XCTAssertNil(request)
+    	guard case .success = result else {
+    		XCTFail("Expected the waiting to complete immediately")
+    		return
+		}
+
+    	// Not ready yet, the regular path then.
+    	loadable.isContentsAvailable = false
+    	result = nil
+    	let done = expectation(description: "Waiting completed")
+    	XCTAssertNotNil(loadableHasContentsAvailable.wait(completingSynchronouslyIfReady: true) { _ in done.fulfill() })
+    	XCTAssertNil(result)
+    	loadable.isContentsAvailable = true
+    	loadable.notifyDidChange()
+		wait(for: [done], timeout: 1)
+    }
 }
@@ -0,0 +1,105 @@
+//
+// MMMLoadable. Part of MMMTemple.
+// Copyright (C) 2016-2020 MediaMonks. All rights reserved.
+//
+
+import MMMLoadable
+import XCTest
+
+class MMMThreadSafeLoadableTestCase: XCTestCase {
+
+	private class TestLoadable: MMMThreadSafeLoadable {
+
+		override func doSync() {}
+
+		override var isContentsAvailable: Bool { false }
+	}
+
+	func testConcurrentTransitions() {
+
+		let loadable = TestLoadable()
+		let error = NSError(domain: "Test", code: 1)
+
+		DispatchQueue.concurrentPerform(iterations: 8) { worker in
+			for i in 0..<1000 {
+				switch (worker + i) % 4 {
+				case 0:
+					loadable.sync()
+				case 1:
+					loadable.setFailedToSyncWithError(error)
+				case 2:
+					loadable.setDidSyncSuccessfully()
+				default:
+					// Readers: the error should always match the state it was published with.
+					var generation: UInt64 = 0
+					let state = loadable.loadableState(withGeneration: &generation)
+					let currentError = loadable.error as NSError?
+					if state == .didFailToSync, loadable.changeGeneration == generation {
+						XCTAssert(currentError === error)
+					}
+				}
+			}
+		}
+
+		loadable.setFailedToSyncWithError(error)
+		XCTAssertEqual(loadable.loadableState, .didFailToSync)
+		XCTAssert(loadable.error as NSError? === error)
+
+		// Only one of concurrent syncs should begin.
+		let generation = loadable.changeGeneration
+		DispatchQueue.concurrentPerform(iterations: 8) { _ in loadable.sync() }
+		XCTAssertEqual(loadable.changeGeneration - generation, 1)
+		XCTAssertEqual(loadable.loadableState, .syncing)
+		XCTAssertNil(loadable.error)
+	}
+
+	func testBatchUpdates() {
+
+		let loadable = TestLoadable()
+		var count = 0
+		let observer = MMMLoadableObserver(loadable: loadable) { _ in count += 1 }
+
+		// Should complete delivering the postponed notification once, not loop forever.
+		MMMLoadablePerformBatchUpdates {
+			loadable.sync()
+			loadable.setDidSyncSuccessfully()
+			XCTAssertEqual(count, 0)
+		}
+		XCTAssertEqual(count, 1)
+		XCTAssertEqual(loadable.loadableState, .didSyncSuccessfully)
+
+		withExtendedLifetime(observer) {}
+	}
+
+	/// Owns the loadable it observes and removes itself in `deinit`, like the proxies do.
+	private class Owner: NSObject, MMMLoadableObserverProtocol {
+
+		let loadable = TestLoadable()
+
+		override init() {
+			super.init()
+			loadable.addObserver(self)
+		}
+
+		deinit {
+			loadable.removeObserver(self)
+		}
+
+		func loadableDidChange(_ loadable: MMMPureLoadableProtocol) {}
+	}
+
+	func testObserversAreNotRetained() {
+
+		weak var weakOwner: Owner?
+		weak var weakLoadable: TestLoadable?
+		autoreleasepool {
+			let owner = Owner()
+			weakOwner = owner
+			weakLoadable = owner.loadable
+			owner.loadable.sync()
+		}
+
+		XCTAssertNil(weakOwner)
+		XCTAssertNil(weakLoadable)
+	}
+}